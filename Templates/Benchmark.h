@@ -0,0 +1,166 @@
+#ifndef Benchmark_h
+#define Benchmark_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ Benchmark - замер времени выполнения (ns/op) и количества выделений памяти в куче (allocations/op).
+ Выделения памяти считаются в глобальном operator new, который переопределен в main.cpp.
+ Количество выполненных инструкций - счетчиком процессора InstructionCounter (только Linux).
+ */
+
+namespace benchmark
+{
+    /// Счетчик выделений памяти, увеличивается в глобальном operator new
+    inline std::atomic<size_t> allocations = 0;
+
+    /// Запрещает компилятору выбросить вычисление, результат которого не используется
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile char sink = *reinterpret_cast<const volatile char*>(&value);
+        (void)sink;
+#endif
+    }
+
+    struct Result
+    {
+        double ns = 0.0;          // Время на 1 итерацию
+        double allocations = 0.0; // Количество выделений памяти на 1 итерацию
+    };
+
+    /// Вызывает function iterations раз и печатает: name: ns/op, allocations/op
+    template <typename TFunction>
+    Result Measure(std::string_view name, size_t iterations, TFunction&& function)
+    {
+        const size_t allocations_before = allocations.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            function();
+        const auto finish = std::chrono::steady_clock::now();
+        const size_t allocations_after = allocations.load(std::memory_order_relaxed);
+
+        Result result;
+        result.ns = std::chrono::duration<double, std::nano>(finish - start).count() / double(iterations);
+        result.allocations = double(allocations_after - allocations_before) / double(iterations);
+        std::cout << name << ": " << result.ns << " ns/op, " << result.allocations << " allocations/op" << std::endl;
+        return result;
+    }
+
+    /// Запускает threads потоков, каждый вызывает function(thread) iterations раз; печатает общее время на 1 операцию (ns/op) и пропускную способность всех потоков (Mops/s)
+    template <typename TFunction>
+    Result MeasureParallel(std::string_view name, size_t threads, size_t iterations, TFunction&& function)
+    {
+        std::atomic<size_t> ready = 0;
+        std::atomic<bool> start = false;
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (size_t thread = 0; thread < threads; ++thread)
+        {
+            workers.emplace_back([&, thread]()
+            {
+                ++ready;
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (size_t i = 0; i < iterations; ++i)
+                    function(thread);
+            });
+        }
+
+        while (ready.load() != threads)
+            std::this_thread::yield();
+        const size_t allocations_before = allocations.load(std::memory_order_relaxed);
+        const auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (auto& worker : workers)
+            worker.join();
+        const auto finish = std::chrono::steady_clock::now();
+        const size_t allocations_after = allocations.load(std::memory_order_relaxed);
+
+        const double operations = double(threads * iterations);
+        Result result;
+        result.ns = std::chrono::duration<double, std::nano>(finish - begin).count() / operations;
+        result.allocations = double(allocations_after - allocations_before) / operations;
+        std::cout << name << " (" << threads << " threads): " << result.ns << " ns/op, " << 1e3 / result.ns << " Mops/s, " << result.allocations << " allocations/op" << std::endl;
+        return result;
+    }
+
+    /*
+     InstructionCounter - аппаратный счетчик инструкций текущего потока в пользовательском режиме (perf_event_open, Linux).
+     Счетчик недоступен на других ОС, в виртуальной машине без PMU и при kernel.perf_event_paranoid > 2: Stop() возвращает std::nullopt.
+     */
+    class InstructionCounter
+    {
+    public:
+        InstructionCounter() noexcept
+        {
+#if defined(__linux__)
+            perf_event_attr attributes{};
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.size = sizeof(attributes);
+            attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            _descriptor = int(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0)); // Текущий поток, любой процессор
+#endif
+        }
+
+        InstructionCounter(const InstructionCounter&) = delete;
+        InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+        ~InstructionCounter()
+        {
+#if defined(__linux__)
+            if (_descriptor >= 0)
+                close(_descriptor);
+#endif
+        }
+
+        bool Available() const noexcept { return _descriptor >= 0; }
+
+        void Start() noexcept
+        {
+#if defined(__linux__)
+            if (_descriptor >= 0)
+            {
+                ioctl(_descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        /// Количество инструкций с последнего Start()
+        std::optional<uint64_t> Stop() noexcept
+        {
+#if defined(__linux__)
+            uint64_t count = 0;
+            if (_descriptor >= 0 && ioctl(_descriptor, PERF_EVENT_IOC_DISABLE, 0) == 0 && read(_descriptor, &count, sizeof(count)) == sizeof(count))
+                return count;
+#endif
+            return std::nullopt;
+        }
+
+    private:
+        int _descriptor = -1;
+    };
+}
+
+#endif /* Benchmark_h */
@@ -1,6 +1,14 @@
 #ifndef CRTP_h
 #define CRTP_h
 
+#include "ShardedCounter.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
 /*
  Сайты: https://infotraining.bitbucket.io/cpp-adv/variadic-templates.html
  */
@@ -67,34 +75,154 @@ namespace CRTP
         };
 
         /*
-         Синглтон Майерса + CRTP
+         Способ создания синглтона:
+         - Lazy: синглтон Майерса - создается при первом вызове Instance(), каждый вызов проверяет флаг инициализации (guard) с синхронизацией между потоками
+         - Eager: constinit - создается при компиляции (нужен constexpr конструктор), Instance() - просто адрес без проверок
+         - ThreadLocal: свой объект в каждом потоке (thread_local), без синхронизации между потоками
+         - Explicit: создается Init() и уничтожается Shutdown() в заданный момент; Lifetime::ShutdownAll() уничтожает все Explicit синглтоны в порядке, обратном Init.
+           Init должен быть вызван до обращений из других потоков (например, до их запуска)
          */
-        template<class Derived>
+        enum class Initialization
+        {
+            Lazy,
+            Eager,
+            ThreadLocal,
+            Explicit
+        };
+
+        /// Порядок уничтожения Explicit синглтонов: стек функций Shutdown в порядке вызова Init
+        class Lifetime
+        {
+            template <class Derived, Initialization initialization>
+            friend struct Singleton;
+
+        public:
+            static void ShutdownAll()
+            {
+                for (;;)
+                {
+                    void (*shutdown)() = nullptr;
+                    {
+                        std::lock_guard lock(Mutex());
+                        if (Stack().empty())
+                            return;
+                        shutdown = Stack().back();
+                    }
+                    shutdown(); // Удаляет себя из стека
+                }
+            }
+
+        private:
+            static void Push(void (*shutdown)())
+            {
+                std::lock_guard lock(Mutex());
+                Stack().push_back(shutdown);
+            }
+
+            static void Remove(void (*shutdown)())
+            {
+                std::lock_guard lock(Mutex());
+                std::erase(Stack(), shutdown);
+            }
+
+            static std::mutex& Mutex()
+            {
+                static std::mutex mutex;
+                return mutex;
+            }
+
+            static std::vector<void (*)()>& Stack()
+            {
+                static std::vector<void (*)()> stack;
+                return stack;
+            }
+        };
+
+        /*
+         Синглтон + CRTP, способ создания - Initialization
+         */
+        template<class Derived, Initialization initialization = Initialization::Lazy>
         struct Singleton : private NonCopyable, private NonMoveable // Делаем приватные конструкторы базовых классов
         {
             static Derived &Instance()
             {
-                static Derived instance;
-                return instance;
+                if constexpr (initialization == Initialization::Lazy)
+                {
+                    static Derived instance;
+                    return instance;
+                }
+                else if constexpr (initialization == Initialization::Eager)
+                {
+                    return _instance;
+                }
+                else if constexpr (initialization == Initialization::ThreadLocal)
+                {
+                    return _thread_instance;
+                }
+                else
+                {
+                    if (!_explicit_instance)
+                        throw std::logic_error("Singleton::Init was not called");
+                    return *_explicit_instance;
+                }
+            }
+            
+            /// Только Explicit: создание с аргументами конструктора
+            template <typename... Args>
+            static Derived &Init(Args&&... args)
+            {
+                static_assert(initialization == Initialization::Explicit, "Init is available only for Initialization::Explicit");
+                if (_explicit_instance)
+                    throw std::logic_error("Singleton::Init was called twice");
+                _explicit_instance = new Derived(std::forward<Args>(args)...);
+                Lifetime::Push(&Shutdown);
+                return *_explicit_instance;
+            }
+            
+            static void Shutdown()
+            {
+                static_assert(initialization == Initialization::Explicit, "Shutdown is available only for Initialization::Explicit");
+                if (!_explicit_instance)
+                    return;
+                Lifetime::Remove(&Shutdown);
+                delete std::exchange(_explicit_instance, nullptr);
             }
             
         protected:
-            Singleton() = default;
+            constexpr Singleton() = default;
+            
+        private:
+            inline static constinit Derived _instance;             // Eager
+            inline static thread_local Derived _thread_instance;   // ThreadLocal
+            inline static Derived* _explicit_instance = nullptr;   // Explicit
         };
 
         struct Singleton1 : public Singleton<Singleton1>{};
         struct Singleton2 : public Singleton<Singleton2>{};
+        struct EagerSingleton : public Singleton<EagerSingleton, Initialization::Eager>{};
+        struct ThreadLocalSingleton : public Singleton<ThreadLocalSingleton, Initialization::ThreadLocal>{};
+        struct ExplicitSingleton : public Singleton<ExplicitSingleton, Initialization::Explicit>{};
     }
 
+    /// Количество живых объектов T без гонки данных: счетчик разбит на части по потокам, тип T регистрируется в telemetry::CounterRegistry
     template <typename T>
     class Counter
     {
     public:
-        Counter() { ++_counter; }
-        ~Counter() { --_counter; }
-        static size_t count() noexcept { return _counter; }
+        Counter() noexcept { Increment(); }
+        Counter(const Counter&) noexcept { Increment(); } // Копия - тоже живой объект, который уменьшит счетчик в деструкторе
+        Counter& operator=(const Counter&) = default;
+        ~Counter() { _counter.Decrement(); }
+        static size_t count() noexcept { return _counter.Count(); }
+    private:
+        static void Increment() noexcept
+        {
+            (void)_registered; // Обращение инстанцирует _registered: регистрация при инициализации программы
+            _counter.Increment();
+        }
     private:
-        inline static size_t _counter;
+        inline static constinit telemetry::ShardedCounter _counter; // Константная инициализация: объекты, созданные до динамической инициализации, не теряются
+        inline static const bool _registered = telemetry::CounterRegistry::Instance().Add(telemetry::TypeName(typeid(T)), _counter);
     };
 
     template <typename T>
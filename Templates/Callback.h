@@ -1,7 +1,13 @@
 #ifndef Callback_h
 #define Callback_h
 
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace callback
 {
@@ -52,6 +58,215 @@ namespace callback
         _CallBack _callback;
     };
 
+    /*
+     InplaceCallback - вызываемый объект с сигнатурой Signature, хранящийся во внутреннем буфере размером Capacity (small buffer) без выделения памяти в куче.
+     В отличие от std::function:
+     - никогда не выделяет память: если объект не помещается в буфер - ошибка компиляции, а не выделение памяти в куче
+     - только перемещаемый (move-only): можно хранить некопируемые объекты (std::unique_ptr)
+     - объект, метод и аргументы хранятся напрямую (как std::bind, но без std::function поверх)
+     Стирание типа (type erasure): указатель на функцию-вызов и указатель на таблицу перемещения/уничтожения, сгенерированные шаблоном для конкретного типа.
+     */
+    template <typename Signature, size_t Capacity = 4 * sizeof(void*)>
+    class InplaceCallback;
+
+    template <typename TResult, typename... Args, size_t Capacity>
+    class InplaceCallback<TResult(Args...), Capacity>
+    {
+        /// Объект, метод и аргументы, связанные заранее: (object.*method)(args..., call_args...)
+        template <class TClass, class TMethod, class... TArgs>
+        struct Bound
+        {
+            TResult operator()(Args... call_args)
+            {
+                return std::apply([&](TArgs&... args) -> TResult
+                {
+                    return std::invoke(_method, _class, args..., std::forward<Args>(call_args)...);
+                }, _args);
+            }
+
+            [[no_unique_address]] TClass _class;
+            TMethod _method;
+            [[no_unique_address]] std::tuple<TArgs...> _args;
+        };
+
+        struct Operations
+        {
+            void (*move)(void* from, void* to) noexcept;
+            void (*destroy)(void* object) noexcept;
+        };
+
+        template <class TFunction>
+        constexpr static Operations operations =
+        {
+            [](void* from, void* to) noexcept { new (to) TFunction(std::move(*static_cast<TFunction*>(from))); },
+            [](void* object) noexcept { static_cast<TFunction*>(object)->~TFunction(); }
+        };
+
+    public:
+        InplaceCallback() noexcept = default;
+
+        template <class TFunction>
+        requires (!std::is_same_v<std::decay_t<TFunction>, InplaceCallback> && std::is_invocable_r_v<TResult, std::decay_t<TFunction>&, Args...>)
+        InplaceCallback(TFunction&& function)
+        {
+            Emplace<std::decay_t<TFunction>>(std::forward<TFunction>(function));
+        }
+
+        /// Объект копируется, метод и аргументы хранятся по значению: InplaceCallback<void()>(example, &Example::Method2, true, false)
+        template <class TClass, class TMethod, class... TArgs>
+        requires std::is_member_function_pointer_v<TMethod>
+        InplaceCallback(TClass&& iClass, TMethod iMethod, TArgs&&... iArgs)
+        {
+            using TBound = Bound<std::decay_t<TClass>, TMethod, std::decay_t<TArgs>...>;
+            Emplace<TBound>(TBound{std::forward<TClass>(iClass), iMethod, std::tuple<std::decay_t<TArgs>...>(std::forward<TArgs>(iArgs)...)});
+        }
+
+        InplaceCallback(InplaceCallback&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        InplaceCallback& operator=(InplaceCallback&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        InplaceCallback(const InplaceCallback&) = delete;
+        InplaceCallback& operator=(const InplaceCallback&) = delete;
+
+        ~InplaceCallback()
+        {
+            Reset();
+        }
+
+        TResult operator()(Args... args)
+        {
+            return _invoke(_storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept { return _invoke != nullptr; }
+
+        void Reset() noexcept
+        {
+            if (_invoke)
+            {
+                _operations->destroy(_storage);
+                _invoke = nullptr;
+                _operations = nullptr;
+            }
+        }
+
+    private:
+        template <class TFunction, class T>
+        void Emplace(T&& function)
+        {
+            static_assert(sizeof(TFunction) <= Capacity, "callback state does not fit into InplaceCallback, increase Capacity");
+            static_assert(alignof(TFunction) <= alignof(std::max_align_t), "callback state is over-aligned");
+            static_assert(std::is_nothrow_move_constructible_v<TFunction>, "callback state must be nothrow move constructible");
+
+            new (_storage) TFunction(std::forward<T>(function));
+            _invoke = [](void* object, Args&&... args) -> TResult
+            {
+                return (*static_cast<TFunction*>(object))(std::forward<Args>(args)...);
+            };
+            _operations = &operations<TFunction>;
+        }
+
+        void MoveFrom(InplaceCallback& other) noexcept
+        {
+            if (other._invoke)
+            {
+                other._operations->move(other._storage, _storage);
+                _invoke = other._invoke;
+                _operations = other._operations;
+                other.Reset();
+            }
+        }
+
+    private:
+        alignas(std::max_align_t) unsigned char _storage[Capacity];
+        TResult (*_invoke)(void*, Args&&...) = nullptr; // Вызов хранится в объекте: без косвенного обращения к таблице
+        const Operations* _operations = nullptr;
+    };
+
+    /// Сигнатура метода без класса: void(Example::*)(bool) -> void(bool)
+    template <typename TMethod>
+    struct MethodTraits;
+
+    template <class TClass, typename TResult, typename... Args>
+    struct MethodTraits<TResult(TClass::*)(Args...)>
+    {
+        using Class = TClass;
+        using Signature = TResult(Args...);
+    };
+
+    template <class TClass, typename TResult, typename... Args>
+    struct MethodTraits<TResult(TClass::*)(Args...) const>
+    {
+        using Class = const TClass;
+        using Signature = TResult(Args...);
+    };
+
+    /*
+     Delegate - невладеющая ссылка на метод объекта размером в 2 машинных слова: указатель на объект и указатель на функцию-переходник (thunk).
+     Указатель на метод - non-type template параметр функции-переходника, поэтому не хранится в объекте (сам указатель на метод занимает 2 слова в Itanium ABI).
+     Тривиально копируемый, без выделения памяти и без виртуального вызова; объект не копируется - Delegate не должен пережить объект.
+     Сравнение на равенство (тот же объект и тот же метод) позволяет отписаться: найти и удалить Delegate из списка подписчиков.
+     */
+    template <typename Signature>
+    class Delegate;
+
+    template <typename TResult, typename... Args>
+    class Delegate<TResult(Args...)>
+    {
+    public:
+        constexpr Delegate() noexcept = default;
+
+        /// Delegate<void(bool)>::Bind<&Example::Method1>(example)
+        template <auto Method, class TClass>
+        constexpr static Delegate Bind(TClass& iClass) noexcept
+        {
+            static_assert(std::is_invocable_r_v<TResult, decltype(Method), TClass&, Args...>, "method does not match the delegate signature");
+            Delegate delegate;
+            delegate._object = const_cast<void*>(static_cast<const void*>(std::addressof(iClass)));
+            delegate._thunk = &Thunk<Method, TClass>;
+            return delegate;
+        }
+
+        TResult operator()(Args... args) const
+        {
+            return _thunk(_object, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept { return _thunk != nullptr; }
+
+        friend constexpr bool operator==(const Delegate&, const Delegate&) noexcept = default;
+
+    private:
+        /// Отдельная функция для каждой пары (класс, метод): вызов метода - прямой, известный компилятору
+        template <auto Method, class TClass>
+        static TResult Thunk(void* object, Args... args)
+        {
+            return (static_cast<TClass*>(object)->*Method)(std::forward<Args>(args)...);
+        }
+
+    private:
+        void* _object = nullptr;
+        TResult (*_thunk)(void*, Args...) = nullptr;
+    };
+
+    /// Сигнатура выводится из метода: MakeDelegate<&Example::Method2>(example) -> Delegate<void(bool, bool)>
+    template <auto Method, class TClass>
+    constexpr auto MakeDelegate(TClass& iClass) noexcept
+    {
+        return Delegate<typename MethodTraits<decltype(Method)>::Signature>::template Bind<Method>(iClass);
+    }
+
     class Example
     {
     public:
@@ -80,21 +295,20 @@ namespace callback
     class Permission
     {
     public:
+        /// Объект, метод и аргументы хранятся внутри InplaceCallback: без выделения памяти в куче
         Permission(const Example& iClass, TCallBack&& iCallback)
         {
             if constexpr (std::is_same_v<void(Example::*)(), TCallBack>)
             {
-                _callback.reset(new Callback(iClass, iCallback));
+                _callback = InplaceCallback<void()>(iClass, iCallback);
             }
             else if constexpr (std::is_same_v<void(Example::*)(bool), TCallBack>)
             {
-                bool flag = true;
-                _callback.reset(new Callback(iClass, iCallback, std::ref(flag)));
+                _callback = InplaceCallback<void()>(iClass, iCallback, true);
             }
             else if constexpr (std::is_same_v<void(Example::*)(bool, bool), TCallBack>)
             {
-                bool flag = true;
-                _callback.reset(new Callback(iClass, iCallback, std::ref(flag), std::ref(flag)));
+                _callback = InplaceCallback<void()>(iClass, iCallback, true, true);
             }
         }
 
@@ -102,12 +316,12 @@ namespace callback
         {
             if (_callback)
             {
-                (*_callback)();
+                _callback();
             }
         }
 
     private:
-        std::unique_ptr<ICallback> _callback;
+        InplaceCallback<void()> _callback;
     };
 }
 
@@ -0,0 +1,198 @@
+#ifndef CallbackQueue_h
+#define CallbackQueue_h
+
+#include "Callback.h"
+
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+/*
+ CoalescingQueue - очередь отложенных вызовов методов, которая схлопывает (coalesce) повторы: ключ задачи - пара (объект, метод).
+ Если тот же метод того же объекта поставлен в очередь повторно до Drain, новая задача заменяет ожидающую (с новыми аргументами), а не добавляется еще одна:
+ сотня Post подряд - один вызов с последними аргументами. Задача выполняется на месте первой постановки, порядок разных ключей сохраняется.
+ Drain выполняет O(уникальных ключей) вызовов, индекс ключей - хеш-таблица с открытой адресацией, которая очищается за O(1) и не выделяет память в установившемся режиме. Задачи, поставленные во время Drain, выполнятся в следующем Drain.
+ Объект не копируется (хранится указатель), аргументы хранятся по значению внутри InplaceCallback - без выделения памяти на задачу.
+ Drain выполняется одним потоком: Drain из другого потока или из callback во время Drain сразу возвращает 0.
+ Исключение из callback пробрасывается из Drain, невыполненные задачи возвращаются в начало очереди и выполнятся в следующем Drain.
+ */
+
+namespace callback
+{
+    class CoalescingQueue
+    {
+    public:
+        struct Stats
+        {
+            size_t posted = 0;    // Всего вызовов Post
+            size_t coalesced = 0; // Post, заменившие ожидающую задачу
+            size_t executed = 0;  // Выполненные задачи
+            size_t drains = 0;    // Вызовы Drain
+        };
+
+        /// Post<&Example::Method1>(example, true): заменяет ожидающий вызов Example::Method1 для example, если он есть
+        template <auto Method, class TClass, class... TArgs>
+        void Post(TClass& iClass, TArgs&&... iArgs)
+        {
+            static_assert(std::is_member_function_pointer_v<decltype(Method)>, "Method must be a member function pointer");
+
+            const Key key{std::addressof(iClass), &MethodTag<Method>};
+            InplaceCallback<void()> callback(std::addressof(iClass), Method, std::forward<TArgs>(iArgs)...);
+
+            std::lock_guard lock(_mutex);
+            ++_stats.posted;
+            if (Insert(key, std::move(callback)))
+                ++_stats.coalesced;
+        }
+
+        /// Выполняет все ожидающие задачи, возвращает их количество (задача, бросившая исключение, считается выполненной)
+        size_t Drain()
+        {
+            {
+                std::lock_guard lock(_mutex);
+                if (_draining)
+                    return 0;
+                _draining = true;
+                std::swap(_pending, _running); // Буферы переиспользуются: без выделения памяти в установившемся режиме
+                NextGeneration();
+                ++_stats.drains;
+            }
+
+            size_t executed = 0;
+            try
+            {
+                while (executed < _running.size())
+                    _running[executed++].callback();
+            }
+            catch (...)
+            {
+                Finish(executed);
+                throw;
+            }
+            Finish(executed);
+            return executed;
+        }
+
+        size_t Size() const
+        {
+            std::lock_guard lock(_mutex);
+            return _pending.size();
+        }
+
+        Stats GetStats() const
+        {
+            std::lock_guard lock(_mutex);
+            return _stats;
+        }
+
+    private:
+        /// Уникальный адрес для каждого метода: указатели на методы нельзя хешировать, а адрес переменной - можно.
+        /// Не const: одинаковые константы компоновщик может склеить в одну (MSVC /OPT:ICF), и разные методы получили бы один ключ
+        template <auto Method>
+        inline static char MethodTag = 0;
+
+        struct Key
+        {
+            const void* object;
+            const void* method;
+
+            bool operator==(const Key&) const = default;
+        };
+
+        /// Ячейка индекса занята, если ее поколение равно текущему: очистка индекса в Drain - это O(1) увеличение поколения
+        struct Slot
+        {
+            uint32_t generation = 0;
+            uint32_t index = 0; // Позиция задачи в _pending
+        };
+
+        struct Entry
+        {
+            Key key;
+            InplaceCallback<void()> callback;
+        };
+
+        static size_t Hash(const Key& key) noexcept
+        {
+            const auto object = reinterpret_cast<uintptr_t>(key.object);
+            const auto method = reinterpret_cast<uintptr_t>(key.method);
+            return size_t((object ^ (method * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull >> 16);
+        }
+
+        /// Вызывается под _mutex; true - задача заменила ожидающую с тем же ключом
+        bool Insert(const Key& key, InplaceCallback<void()>&& callback)
+        {
+            Slot& slot = Find(key);
+            if (slot.generation == _generation)
+            {
+                _pending[slot.index].callback = std::move(callback);
+                return true;
+            }
+            slot = Slot{_generation, uint32_t(_pending.size())};
+            _pending.push_back(Entry{key, std::move(callback)});
+            if (_pending.size() * 2 > _slots.size())
+                Rehash(_slots.size() * 2);
+            return false;
+        }
+
+        /// Конец Drain: задачи после executed (не выполнены из-за исключения) возвращаются в начало очереди
+        void Finish(size_t executed)
+        {
+            std::lock_guard lock(_mutex);
+            if (executed < _running.size())
+            {
+                /// Задача того же ключа, поставленная во время Drain, новее: заменяет невыполненную на ее месте
+                std::vector<Entry> posted;
+                posted.swap(_pending);
+                _pending.assign(std::make_move_iterator(_running.begin() + executed), std::make_move_iterator(_running.end()));
+                size_t size = _slots.size();
+                while (_pending.size() * 2 > size)
+                    size *= 2;
+                Rehash(size);
+                for (Entry& entry : posted)
+                    Insert(entry.key, std::move(entry.callback));
+            }
+            _running.clear();
+            _stats.executed += executed;
+            _draining = false;
+        }
+
+        /// Ячейка с ключом key или свободная ячейка, в которую его нужно вставить
+        Slot& Find(const Key& key)
+        {
+            const size_t mask = _slots.size() - 1;
+            for (size_t position = Hash(key) & mask;; position = (position + 1) & mask)
+            {
+                Slot& slot = _slots[position];
+                if (slot.generation != _generation || _pending[slot.index].key == key)
+                    return slot;
+            }
+        }
+
+        void Rehash(size_t size)
+        {
+            _slots.assign(size, Slot());
+            _generation = 1;
+            for (size_t index = 0; index < _pending.size(); ++index)
+                Find(_pending[index].key) = Slot{_generation, uint32_t(index)};
+        }
+
+        void NextGeneration()
+        {
+            if (++_generation == 0) // Переполнение: ячейки старых поколений могли бы стать занятыми
+                Rehash(_slots.size());
+        }
+
+    private:
+        mutable std::mutex _mutex;
+        std::vector<Slot> _slots = std::vector<Slot>(64); // Открытая адресация (open addressing) с линейным пробированием, размер - степень 2
+        uint32_t _generation = 1;
+        std::vector<Entry> _pending;
+        std::vector<Entry> _running; // Задачи текущего Drain
+        bool _draining = false;
+        Stats _stats;
+    };
+}
+
+#endif /* CallbackQueue_h */
@@ -0,0 +1,358 @@
+#ifndef Coroutine_h
+#define Coroutine_h
+
+#include "Callback.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <optional>
+
+/*
+ Task<T> - ленивая (lazy) корутина C++20: начинает выполняться только при co_await или SyncWait.
+ Вместо вложенных callback последовательность асинхронных шагов пишется линейно:
+ co_await RunAsync(pool, permission1); co_await RunAsync(pool, permission2); co_return result;
+ - Симметричная передача управления (symmetric transfer): await_suspend возвращает coroutine_handle, которую нужно продолжить,
+   поэтому цепочка из миллиона синхронно завершающихся co_await не растит стек (resume не вызывается вложенно).
+   Clang и MSVC гарантируют хвостовой вызов (tail call) продолжения, GCC - только с оптимизацией (-O1 и выше)
+ - Фреймы корутин выделяются из FramePool: потоковый (thread_local) список свободных блоков по классам размеров, без блокировок и без глобальной кучи в установившемся режиме
+ - RunAsync(callback) - awaitable для Permission и ICallback: без исполнителя вызов выполняется сразу, с исполнителем (ThreadPool) - в потоке исполнителя, и корутина продолжается там же
+ */
+
+namespace callback
+{
+    /// Повторное использование памяти фреймов корутин: блоки кратны 64 байтам, до 1024 байт; крупнее - ::operator new
+    class FramePool
+    {
+        constexpr static size_t granularity = 64;
+        constexpr static size_t classes = 16;
+        constexpr static size_t limit = 1024; // Максимум свободных блоков одного класса в потоке
+
+        struct Block
+        {
+            Block* next;
+        };
+
+        /// Фрейм может быть уничтожен в другом потоке: блок попадает в список этого потока
+        struct Cache
+        {
+            ~Cache()
+            {
+                for (Block*& head : heads)
+                {
+                    while (head)
+                        ::operator delete(std::exchange(head, head->next));
+                }
+            }
+
+            Block* heads[classes] = {};
+            size_t counts[classes] = {};
+        };
+
+    public:
+        static void* Allocate(size_t size)
+        {
+            const size_t index = (size - 1) / granularity;
+            if (index >= classes)
+                return ::operator new(size);
+            Cache& cache = _cache;
+            if (Block* block = cache.heads[index])
+            {
+                cache.heads[index] = block->next;
+                --cache.counts[index];
+                return block;
+            }
+            return ::operator new((index + 1) * granularity);
+        }
+
+        static void Deallocate(void* pointer, size_t size) noexcept
+        {
+            const size_t index = (size - 1) / granularity;
+            Cache& cache = _cache;
+            if (index >= classes || cache.counts[index] == limit)
+            {
+                ::operator delete(pointer);
+                return;
+            }
+            cache.heads[index] = new (pointer) Block{cache.heads[index]};
+            ++cache.counts[index];
+        }
+
+    private:
+        static thread_local Cache _cache;
+    };
+
+    inline thread_local FramePool::Cache FramePool::_cache;
+
+    template <typename T = void>
+    class Task;
+
+    /// Состояние ожидания SyncWait: уведомление под блокировкой, поэтому SyncWait не вернется, пока корутина не закончит работу с ним
+    struct SyncState
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+    };
+
+    struct PromiseBase
+    {
+        /// Последний шаг: передача управления ожидающей корутине (symmetric transfer) или уведомление SyncWait
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> handle) noexcept
+            {
+                PromiseBase& promise = handle.promise();
+                if (SyncState* waiter = promise.waiter)
+                {
+                    std::lock_guard lock(waiter->mutex);
+                    waiter->done = true;
+                    waiter->condition.notify_one();
+                    return std::noop_coroutine();
+                }
+                return promise.continuation;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        static void* operator new(size_t size)
+        {
+            return FramePool::Allocate(size);
+        }
+
+        static void operator delete(void* pointer, size_t size) noexcept
+        {
+            FramePool::Deallocate(pointer, size);
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        SyncState* waiter = nullptr;
+        std::exception_ptr exception;
+    };
+
+    template <typename T>
+    struct Promise : PromiseBase
+    {
+        Task<T> get_return_object() noexcept;
+
+        template <typename U = T>
+        requires std::is_convertible_v<U&&, T>
+        void return_value(U&& result)
+        {
+            value.emplace(std::forward<U>(result));
+        }
+
+        std::optional<T> value;
+    };
+
+    template <>
+    struct Promise<void> : PromiseBase
+    {
+        Task<void> get_return_object() noexcept;
+        void return_void() const noexcept {}
+    };
+
+    template <typename T>
+    class Task
+    {
+        template <typename U>
+        friend U SyncWait(Task<U> task);
+
+    public:
+        using promise_type = Promise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() noexcept = default;
+        explicit Task(Handle handle) noexcept : _handle(handle) {}
+        Task(Task&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (_handle)
+                    _handle.destroy();
+                _handle = std::exchange(other._handle, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task()
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+
+        /// co_await task: ожидающая корутина запоминается, управление сразу передается задаче
+        auto operator co_await() noexcept
+        {
+            struct Awaiter
+            {
+                bool await_ready() const noexcept { return !handle || handle.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() { return Result(handle); }
+
+                Handle handle;
+            };
+            return Awaiter{_handle};
+        }
+
+    private:
+        static T Result(Handle handle)
+        {
+            promise_type& promise = handle.promise();
+            if (promise.exception)
+                std::rethrow_exception(promise.exception);
+            if constexpr (!std::is_void_v<T>)
+                return std::move(*promise.value);
+        }
+
+    private:
+        Handle _handle;
+    };
+
+    template <typename T>
+    Task<T> Promise<T>::get_return_object() noexcept
+    {
+        return Task<T>(std::coroutine_handle<Promise>::from_promise(*this));
+    }
+
+    inline Task<void> Promise<void>::get_return_object() noexcept
+    {
+        return Task<void>(std::coroutine_handle<Promise>::from_promise(*this));
+    }
+
+    /// Запуск задачи из синхронного кода и ожидание результата (задача может завершиться в другом потоке)
+    template <typename T>
+    T SyncWait(Task<T> task)
+    {
+        SyncState state;
+        task._handle.promise().waiter = &state;
+        task._handle.resume();
+        {
+            std::unique_lock lock(state.mutex);
+            state.condition.wait(lock, [&state]() { return state.done; });
+        }
+        return Task<T>::Result(task._handle);
+    }
+
+    /// Permission::Run() или ICallback::operator()
+    template <class TCallable>
+    void Invoke(TCallable& callable)
+    {
+        if constexpr (requires { callable.Run(); })
+            callable.Run();
+        else
+            callable();
+    }
+
+    /// co_await RunAsync(permission): вызов сразу, без приостановки корутины
+    template <class TCallable>
+    class CallbackAwaiter
+    {
+    public:
+        explicit CallbackAwaiter(TCallable& callable) noexcept : _callable(&callable) {}
+
+        bool await_ready() const
+        {
+            Invoke(*_callable);
+            return true;
+        }
+
+        void await_suspend(std::coroutine_handle<>) const noexcept {}
+        void await_resume() const noexcept {}
+
+    private:
+        TCallable* _callable;
+    };
+
+    /// co_await RunAsync(pool, permission): вызов ставится в исполнитель, корутина продолжается в его потоке после вызова
+    template <class TExecutor, class TCallable>
+    class PostedCallbackAwaiter
+    {
+    public:
+        PostedCallbackAwaiter(TExecutor& executor, TCallable& callable) noexcept : _executor(&executor), _callable(&callable) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        /// После Post корутина может продолжиться в другом потоке и уничтожить this: после Post члены не используются
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            _executor->Post(InplaceCallback<void()>([this, handle]()
+            {
+                try
+                {
+                    Invoke(*_callable);
+                }
+                catch (...)
+                {
+                    _exception = std::current_exception();
+                }
+                handle.resume();
+            }));
+        }
+
+        void await_resume() const
+        {
+            if (_exception)
+                std::rethrow_exception(_exception);
+        }
+
+    private:
+        TExecutor* _executor;
+        TCallable* _callable;
+        std::exception_ptr _exception;
+    };
+
+    template <class TCallBack>
+    CallbackAwaiter<Permission<TCallBack>> RunAsync(Permission<TCallBack>& permission) noexcept
+    {
+        return CallbackAwaiter<Permission<TCallBack>>(permission);
+    }
+
+    /// Временный Permission живет до конца полного выражения с co_await
+    template <class TCallBack>
+    CallbackAwaiter<Permission<TCallBack>> RunAsync(Permission<TCallBack>&& permission) noexcept
+    {
+        return CallbackAwaiter<Permission<TCallBack>>(permission);
+    }
+
+    inline CallbackAwaiter<ICallback> RunAsync(ICallback& callback) noexcept
+    {
+        return CallbackAwaiter<ICallback>(callback);
+    }
+
+    /// Исполнитель - любой класс с Post(InplaceCallback<void()>&&), например ThreadPool
+    template <class TExecutor, class TCallBack>
+    PostedCallbackAwaiter<TExecutor, Permission<TCallBack>> RunAsync(TExecutor& executor, Permission<TCallBack>& permission) noexcept
+    {
+        return PostedCallbackAwaiter<TExecutor, Permission<TCallBack>>(executor, permission);
+    }
+
+    template <class TExecutor>
+    PostedCallbackAwaiter<TExecutor, ICallback> RunAsync(TExecutor& executor, ICallback& callback) noexcept
+    {
+        return PostedCallbackAwaiter<TExecutor, ICallback>(executor, callback);
+    }
+}
+
+#endif /* Coroutine_h */
@@ -0,0 +1,186 @@
+#ifndef Dispatch_h
+#define Dispatch_h
+
+#include "Callback.h"
+#include "CRTP.h"
+#include "Matching.h"
+#include "invoke_apply.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <variant>
+#include <vector>
+
+/*
+ Dispatch - одинаковые операции для сравнения способов косвенного вызова из проекта:
+ - виртуальная функция: callback::ICallback
+ - std::function: callback::Callback (std::bind объекта и указателя на метод)
+ - статический полиморфизм: CRTP::Base::Interface1 (тип известен при компиляции, для смешанных вызовов - switch по номеру операции)
+ - std::variant + std::visit: matching::C17::third_implementation::Match
+ - указатель на метод: invoke_apply::CallInvoke (std::invoke)
+ Порядок операций (Pattern) показывает цену неверно предсказанного косвенного перехода (branch misprediction):
+ - Monomorphic: всегда одна операция
+ - Predictable: операции по кругу - предсказатель переходов запоминает шаблон
+ - Random: случайные операции
+ */
+
+namespace dispatch
+{
+    struct Accumulator
+    {
+        void Add(int value) { sum += value; }
+        void Sub(int value) { sum -= value; }
+        void Xor(int value) { sum ^= value; }
+
+        long sum = 0;
+    };
+
+    using Method = void (Accumulator::*)(int);
+
+    constexpr Method methods[] = {&Accumulator::Add, &Accumulator::Sub, &Accumulator::Xor};
+    constexpr size_t operations = std::size(methods);
+
+    enum class Pattern
+    {
+        Monomorphic,
+        Predictable,
+        Random
+    };
+
+    /// Номера операций [0, operations) для count вызовов
+    inline std::vector<uint8_t> MakeOperations(Pattern pattern, size_t count)
+    {
+        std::vector<uint8_t> result(count);
+        std::mt19937 random(42);
+        for (size_t i = 0; i < count; ++i)
+        {
+            switch (pattern)
+            {
+                case Pattern::Monomorphic: result[i] = 0; break;
+                case Pattern::Predictable: result[i] = uint8_t(i % operations); break;
+                case Pattern::Random:      result[i] = uint8_t(random() % operations); break;
+            }
+        }
+        return result;
+    }
+
+    /// Отдельный класс для каждой операции: вызов через таблицу виртуальных функций
+    template <Method method>
+    class VirtualOperation final : public callback::ICallback
+    {
+    public:
+        explicit VirtualOperation(Accumulator& accumulator) : _accumulator(accumulator) {}
+
+        void operator()() override
+        {
+            (_accumulator.*method)(1);
+        }
+
+    private:
+        Accumulator& _accumulator;
+    };
+
+    template <Method method>
+    class CRTPOperation : public CRTP::Base<CRTPOperation<method>>
+    {
+    public:
+        explicit CRTPOperation(Accumulator& accumulator) : _accumulator(accumulator) {}
+
+        void Implementation1()
+        {
+            (_accumulator.*method)(1);
+        }
+
+    private:
+        Accumulator& _accumulator;
+    };
+
+    /// Альтернатива std::variant: только тип, без данных
+    template <Method method>
+    struct Operation {};
+
+    using VariantOperation = std::variant<Operation<&Accumulator::Add>, Operation<&Accumulator::Sub>, Operation<&Accumulator::Xor>>;
+
+    /// Callback с разными методами имеет один тип: void (Accumulator::*)(int), поэтому объекты хранятся в одном std::vector
+    using FunctionOperation = callback::Callback<Accumulator*, Method, int>;
+
+    /// Набор объектов каждого способа для одной последовательности операций
+    class Operations
+    {
+    public:
+        Operations(Accumulator& accumulator, const std::vector<uint8_t>& order) :
+        _accumulator(accumulator),
+        _order(order),
+        _add(accumulator),
+        _sub(accumulator),
+        _xor(accumulator)
+        {
+            _virtual.reserve(order.size());
+            _function.reserve(order.size());
+            _variant.reserve(order.size());
+            _method.reserve(order.size());
+            for (uint8_t operation : order)
+            {
+                switch (operation)
+                {
+                    case 0:
+                        _virtual.emplace_back(std::make_unique<VirtualOperation<&Accumulator::Add>>(accumulator));
+                        _variant.emplace_back(Operation<&Accumulator::Add>());
+                        break;
+                    case 1:
+                        _virtual.emplace_back(std::make_unique<VirtualOperation<&Accumulator::Sub>>(accumulator));
+                        _variant.emplace_back(Operation<&Accumulator::Sub>());
+                        break;
+                    default:
+                        _virtual.emplace_back(std::make_unique<VirtualOperation<&Accumulator::Xor>>(accumulator));
+                        _variant.emplace_back(Operation<&Accumulator::Xor>());
+                        break;
+                }
+                _function.emplace_back(&accumulator, methods[operation], 1);
+                _method.push_back(methods[operation]);
+            }
+        }
+
+        size_t Size() const noexcept { return _order.size(); }
+
+        void Virtual(size_t index) { (*_virtual[index])(); }
+
+        void Function(size_t index) { _function[index](); }
+
+        void Static(size_t index)
+        {
+            switch (_order[index])
+            {
+                case 0: _add.Interface1(); break;
+                case 1: _sub.Interface1(); break;
+                default: _xor.Interface1(); break;
+            }
+        }
+
+        void Visit(size_t index)
+        {
+            std::visit(matching::C17::third_implementation::Match
+            {
+                [this](Operation<&Accumulator::Add>) { _accumulator.Add(1); },
+                [this](Operation<&Accumulator::Sub>) { _accumulator.Sub(1); },
+                [this](Operation<&Accumulator::Xor>) { _accumulator.Xor(1); }
+            }, _variant[index]);
+        }
+
+        void Invoke(size_t index) { invoke_apply::CallInvoke(_method[index], _accumulator, 1); }
+
+    private:
+        Accumulator& _accumulator;
+        std::vector<uint8_t> _order;
+        std::vector<std::unique_ptr<callback::ICallback>> _virtual;
+        std::vector<FunctionOperation> _function;
+        CRTPOperation<&Accumulator::Add> _add;
+        CRTPOperation<&Accumulator::Sub> _sub;
+        CRTPOperation<&Accumulator::Xor> _xor;
+        std::vector<VariantOperation> _variant;
+        std::vector<Method> _method;
+    };
+}
+
+#endif /* Dispatch_h */
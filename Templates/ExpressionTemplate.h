@@ -0,0 +1,218 @@
+#ifndef ExpressionTemplate_h
+#define ExpressionTemplate_h
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/*
+ Шаблоны выражений (expression templates) на CRTP: a + b * c - d не вычисляется сразу, а строит дерево типов Binary<minus, Binary<plus, a, Binary<multiplies, b, c>>, d>.
+ Каждый узел наследуется от Expression<Derived> и вызывается статически - static_cast<const Derived&>(*this)[i], как в CRTP::Base, без виртуальных функций.
+ Вычисление происходит при присваивании в Vector: один цикл result[i] = a[i] + b[i] * c[i] - d[i] по всем элементам:
+ - без промежуточных векторов (наивная реализация создает временный вектор и выделяет память на каждый оператор)
+ - один проход по памяти вместо одного прохода на оператор
+ - тело цикла видно компилятору целиком, поэтому цикл векторизуется (SIMD): результат может совпадать с операндом, компилятор добавляет проверку пересечения массивов.
+   Clang векторизует такой цикл с -O2, GCC до 12 включительно - с -O3 (или -O2 -fvect-cost-model=cheap)
+ Узлы хранят операнды-векторы как указатель и размер (без копирования), а вложенные выражения - по значению:
+ auto expression = a + b * c; безопасно, пока живут a, b, c.
+ */
+
+namespace CRTP
+{
+    namespace expression
+    {
+        template <typename Derived>
+        struct Expression
+        {
+            const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
+
+            decltype(auto) operator[](size_t index) const { return derived()[index]; }
+            size_t size() const noexcept { return derived().size(); }
+        };
+
+        template <typename T>
+        class Vector;
+
+        /// Лист дерева: данные вектора без копирования
+        template <typename T>
+        class View : public Expression<View<T>>
+        {
+        public:
+            using value_type = T;
+
+            explicit View(const Vector<T>& vector) noexcept : _data(vector.data()), _size(vector.size()) {}
+
+            T operator[](size_t index) const noexcept { return _data[index]; }
+            size_t size() const noexcept { return _size; }
+
+        private:
+            const T* _data;
+            size_t _size;
+        };
+
+        /// Число в выражении: a * 2.0
+        template <typename T>
+        class Scalar : public Expression<Scalar<T>>
+        {
+        public:
+            using value_type = T;
+
+            Scalar(T value, size_t size) noexcept : _value(value), _size(size) {}
+
+            T operator[](size_t) const noexcept { return _value; }
+            size_t size() const noexcept { return _size; }
+
+        private:
+            T _value;
+            size_t _size;
+        };
+
+        /// Vector хранится в узле как View, остальные выражения - по значению
+        template <typename E>
+        struct OperandTraits
+        {
+            using Type = E;
+        };
+
+        template <typename T>
+        struct OperandTraits<Vector<T>>
+        {
+            using Type = View<T>;
+        };
+
+        template <typename E>
+        using Operand = typename OperandTraits<E>::Type;
+
+        template <typename TOperation, typename L, typename R>
+        class Binary : public Expression<Binary<TOperation, L, R>>
+        {
+        public:
+            using value_type = std::common_type_t<typename L::value_type, typename R::value_type>;
+
+            Binary(const Operand<L>& left, const Operand<R>& right) : _left(left), _right(right)
+            {
+                if (_left.size() != _right.size())
+                    throw std::invalid_argument("expression operands have different sizes");
+            }
+
+            value_type operator[](size_t index) const { return TOperation()(_left[index], _right[index]); }
+            size_t size() const noexcept { return _left.size(); }
+
+        private:
+            Operand<L> _left;
+            Operand<R> _right;
+        };
+
+        template <typename T>
+        class Vector : public Expression<Vector<T>>
+        {
+        public:
+            using value_type = T;
+
+            Vector() = default;
+            explicit Vector(size_t size, T value = T()) : _data(size, value) {}
+            Vector(std::initializer_list<T> values) : _data(values) {}
+
+            /// Vector result = a + b * c - d: вычисление выражения одним циклом
+            template <typename E>
+            Vector(const Expression<E>& expression)
+            {
+                Assign(expression.derived());
+            }
+
+            template <typename E>
+            Vector& operator=(const Expression<E>& expression)
+            {
+                Assign(expression.derived());
+                return *this;
+            }
+
+            T& operator[](size_t index) noexcept { return _data[index]; }
+            const T& operator[](size_t index) const noexcept { return _data[index]; }
+            size_t size() const noexcept { return _data.size(); }
+            T* data() noexcept { return _data.data(); }
+            const T* data() const noexcept { return _data.data(); }
+            auto begin() noexcept { return _data.begin(); }
+            auto end() noexcept { return _data.end(); }
+            auto begin() const noexcept { return _data.begin(); }
+            auto end() const noexcept { return _data.end(); }
+
+        private:
+            /// Результат может совпадать с операндом (a = a + b): элемент i читается до записи элемента i
+            template <typename E>
+            void Assign(const E& expression)
+            {
+                const Operand<E> operand(expression); // Vector - через View: без копирования при a = b
+                const size_t size = operand.size();
+                if (_data.size() != size)
+                    _data.resize(size);
+                T* result = _data.data();
+                for (size_t i = 0; i < size; ++i)
+                    result[i] = operand[i];
+            }
+
+        private:
+            std::vector<T> _data;
+        };
+
+        template <typename L, typename R>
+        Binary<std::plus<>, L, R> operator+(const Expression<L>& left, const Expression<R>& right)
+        {
+            return {Operand<L>(left.derived()), Operand<R>(right.derived())};
+        }
+
+        template <typename L, typename R>
+        Binary<std::minus<>, L, R> operator-(const Expression<L>& left, const Expression<R>& right)
+        {
+            return {Operand<L>(left.derived()), Operand<R>(right.derived())};
+        }
+
+        template <typename L, typename R>
+        Binary<std::multiplies<>, L, R> operator*(const Expression<L>& left, const Expression<R>& right)
+        {
+            return {Operand<L>(left.derived()), Operand<R>(right.derived())};
+        }
+
+        template <typename L, typename R>
+        Binary<std::divides<>, L, R> operator/(const Expression<L>& left, const Expression<R>& right)
+        {
+            return {Operand<L>(left.derived()), Operand<R>(right.derived())};
+        }
+
+        /// Выражение и число: a * 2.0, 2.0 * a
+        template <typename L>
+        Binary<std::multiplies<>, L, Scalar<typename L::value_type>> operator*(const Expression<L>& left, typename L::value_type right)
+        {
+            return {Operand<L>(left.derived()), Scalar<typename L::value_type>(right, left.size())};
+        }
+
+        template <typename R>
+        Binary<std::multiplies<>, Scalar<typename R::value_type>, R> operator*(typename R::value_type left, const Expression<R>& right)
+        {
+            return {Scalar<typename R::value_type>(left, right.size()), Operand<R>(right.derived())};
+        }
+
+        template <typename L>
+        Binary<std::plus<>, L, Scalar<typename L::value_type>> operator+(const Expression<L>& left, typename L::value_type right)
+        {
+            return {Operand<L>(left.derived()), Scalar<typename L::value_type>(right, left.size())};
+        }
+
+        template <typename L>
+        Binary<std::minus<>, L, Scalar<typename L::value_type>> operator-(const Expression<L>& left, typename L::value_type right)
+        {
+            return {Operand<L>(left.derived()), Scalar<typename L::value_type>(right, left.size())};
+        }
+
+        template <typename L>
+        Binary<std::divides<>, L, Scalar<typename L::value_type>> operator/(const Expression<L>& left, typename L::value_type right)
+        {
+            return {Operand<L>(left.derived()), Scalar<typename L::value_type>(right, left.size())};
+        }
+    }
+}
+
+#endif /* ExpressionTemplate_h */
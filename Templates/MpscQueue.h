@@ -0,0 +1,189 @@
+#ifndef MpscQueue_h
+#define MpscQueue_h
+
+#include "Callback.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+
+/*
+ MpscQueue - ограниченная кольцевая очередь без блокировок (lock-free) для многих писателей и одного читателя (multi-producer single-consumer).
+ Подходит для передачи callback-задач из многих потоков в поток-владелец (event loop) вместо std::queue под std::mutex.
+ Алгоритм Дмитрия Вьюкова (bounded MPMC queue), упрощенный для одного читателя:
+ - у каждой ячейки свой счетчик sequence: ячейка свободна для позиции position, если sequence == position, и заполнена, если sequence == position + 1
+ - писатели резервируют позицию через compare_exchange на общем индексе записи, затем без блокировок конструируют элемент в ячейке
+ - читатель один: индекс чтения - обычная переменная, Drain забирает пачку готовых ячеек подряд
+ - исключение из конструктора элемента: позиция уже занята, поэтому ячейка публикуется пустой (tombstone) - Drain пропускает ее, очередь не останавливается
+ Индекс записи, индекс чтения и ячейки лежат в разных линиях кэша (alignas(64)): писатели и читатель не сбрасывают кэш друг друга (false sharing).
+ Поведение при заполненной очереди (backpressure) - non-type template параметр:
+ - Block: писатель ждет, пока читатель освободит ячейку
+ - Drop: элемент отбрасывается, Push возвращает false, счетчик Dropped увеличивается
+ - Fail: Push возвращает false, решение принимает писатель
+ */
+
+namespace callback
+{
+    enum class Backpressure
+    {
+        Block,
+        Drop,
+        Fail
+    };
+
+    template <typename T, size_t Capacity, Backpressure policy = Backpressure::Block>
+    class MpscQueue
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "T must be nothrow move constructible");
+
+        constexpr static size_t mask = Capacity - 1;
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            bool constructed; // false - конструктор элемента бросил исключение, storage пуст
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+    public:
+        MpscQueue() : _cells(new Cell[Capacity])
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        ~MpscQueue()
+        {
+            Drain([](T&&) {});
+        }
+
+        /// Конструирует элемент в очереди из args; false - очередь заполнена (Drop, Fail)
+        template <typename... Args>
+        bool Push(Args&&... args)
+        {
+            size_t position = _enqueue.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;)
+            {
+                cell = &_cells[position & mask];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = intptr_t(sequence) - intptr_t(position);
+                if (difference == 0)
+                {
+                    if (_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0) // Ячейка еще не прочитана: очередь заполнена
+                {
+                    if constexpr (policy == Backpressure::Fail)
+                    {
+                        return false;
+                    }
+                    else if constexpr (policy == Backpressure::Drop)
+                    {
+                        _dropped.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                        position = _enqueue.load(std::memory_order_relaxed);
+                    }
+                }
+                else // Другой писатель уже занял позицию
+                {
+                    position = _enqueue.load(std::memory_order_relaxed);
+                }
+            }
+
+            if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+            {
+                new (cell->storage) T(std::forward<Args>(args)...);
+            }
+            else
+            {
+                try
+                {
+                    new (cell->storage) T(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    /// Без публикации Drain остановился бы на этой ячейке навсегда, а после круга встали бы и писатели
+                    cell->constructed = false;
+                    cell->sequence.store(position + 1, std::memory_order_release);
+                    throw;
+                }
+            }
+            cell->constructed = true;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Только поток-читатель: function(T&&) для каждого готового элемента по порядку, не больше limit; возвращает количество (пустые ячейки не считаются).
+        /// Исключение из function пробрасывается, элемент считается прочитанным и повторно не выдается
+        template <typename TFunction>
+        size_t Drain(TFunction&& function, size_t limit = SIZE_MAX)
+        {
+            /// Освобождение ячейки и при исключении: иначе перемещенный элемент выдавался бы снова (для CallbackRing - вызов пустого callback)
+            struct Release
+            {
+                ~Release()
+                {
+                    if (cell.constructed)
+                        value->~T();
+                    cell.sequence.store(queue._dequeue + Capacity, std::memory_order_release); // Ячейка свободна для позиции через круг
+                    ++queue._dequeue;
+                }
+
+                MpscQueue& queue;
+                Cell& cell;
+                T* value;
+            };
+
+            size_t count = 0;
+            while (count < limit)
+            {
+                Cell& cell = _cells[_dequeue & mask];
+                if (cell.sequence.load(std::memory_order_acquire) != _dequeue + 1)
+                    break; // Пусто или писатель еще конструирует элемент
+
+                const Release release{*this, cell, std::launder(reinterpret_cast<T*>(cell.storage))};
+                if (!cell.constructed)
+                    continue; // Пустая ячейка: только освобождается
+                ++count;
+                function(std::move(*release.value));
+            }
+            return count;
+        }
+
+        /// Только поток-читатель
+        std::optional<T> TryPop()
+        {
+            std::optional<T> result;
+            Drain([&result](T&& value) { result.emplace(std::move(value)); }, 1);
+            return result;
+        }
+
+        size_t Dropped() const noexcept { return _dropped.load(std::memory_order_relaxed); }
+        constexpr static size_t Size() noexcept { return Capacity; }
+
+    private:
+        alignas(64) std::atomic<size_t> _enqueue = 0; // Общий индекс писателей
+        alignas(64) size_t _dequeue = 0;              // Индекс читателя
+        alignas(64) std::unique_ptr<Cell[]> _cells;
+        alignas(64) std::atomic<size_t> _dropped = 0; // Писатели с Drop не сбрасывают из кэша указатель на ячейки
+    };
+
+    /// Очередь callback-задач для потока-владельца
+    template <size_t Capacity, Backpressure policy = Backpressure::Block>
+    using CallbackRing = MpscQueue<InplaceCallback<void()>, Capacity, policy>;
+}
+
+#endif /* MpscQueue_h */
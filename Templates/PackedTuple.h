@@ -0,0 +1,183 @@
+#ifndef PackedTuple_h
+#define PackedTuple_h
+
+#include "Tuple.h"
+#include "TupleAlgorithm.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+/*
+ PackedTuple - tuple битовых полей: ширина каждого поля в битах задается non-type template параметром Field<T, width>.
+ PackedTuple<Field<uint32_t, 12>, Field<bool, 1>, Field<uint8_t, 3>> занимает 2 байта вместо 8 байт у Tuple<uint32_t, bool, uint8_t>.
+ Поля раскладываются по машинным словам во время компиляции (first fit: поле занимает первое слово, в котором осталось достаточно бит), поле не пересекает границу слова.
+ Поэтому Get - это сдвиг и маска одного слова, Set - маска, сдвиг и OR; номер слова, сдвиг и маска - константы времени компиляции.
+ Тип слова - наименьший из uint8_t/uint16_t/uint32_t/uint64_t, в который помещается самое широкое поле и сумма ширин (если она не больше 64 бит).
+ Значение, не помещающееся в width бит, обрезается. Знаковые поля хранятся в дополнительном коде и расширяются знаком при чтении.
+ В отличие от битовых полей структуры (uint32_t value : 12) раскладка не зависит от компилятора, и поля можно перебирать алгоритмами из TupleAlgorithm.h.
+ Transform, Zip и TupleCat возвращают обычный Tuple: ширина поля задана для исходного типа и не подходит для результата function.
+ */
+
+namespace tuple
+{
+    namespace packed
+    {
+        template <typename T, size_t width>
+        struct Field
+        {
+            static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "field type must be integral or enum");
+            static_assert(width > 0 && width <= sizeof(T) * CHAR_BIT, "width must be in [1, bits of T]");
+            static_assert(width <= 64, "width must fit into uint64_t");
+
+            using Type = T;
+            constexpr static size_t bits = width;
+        };
+
+        template <size_t bits>
+        using WordType = std::conditional_t<bits <= 8, uint8_t,
+                         std::conditional_t<bits <= 16, uint16_t,
+                         std::conditional_t<bits <= 32, uint32_t, uint64_t>>>;
+
+        /// Раскладка полей по словам: word[index] - номер слова, shift[index] - сдвиг поля в слове
+        template <typename... Fields>
+        struct PackedLayout
+        {
+            constexpr static size_t total = (size_t(0) + ... + Fields::bits);
+            using Word = WordType<total <= 64 ? total : std::max({size_t(1), Fields::bits...})>;
+            constexpr static size_t word_bits = sizeof(Word) * CHAR_BIT;
+
+            struct Positions
+            {
+                std::array<size_t, sizeof...(Fields)> word{};
+                std::array<size_t, sizeof...(Fields)> shift{};
+                size_t words = 0;
+            };
+
+            constexpr static Positions positions = []
+            {
+                constexpr size_t bits[] = {Fields::bits..., 0};
+                Positions result;
+                std::array<size_t, sizeof...(Fields) + 1> used{}; // Занятые биты в каждом слове
+                for (size_t field = 0; field < sizeof...(Fields); ++field)
+                {
+                    size_t word = 0;
+                    while (used[word] + bits[field] > word_bits)
+                        ++word;
+                    result.word[field] = word;
+                    result.shift[field] = used[word];
+                    used[word] += bits[field];
+                    result.words = std::max(result.words, word + 1);
+                }
+                return result;
+            }();
+        };
+
+        template <typename... Fields>
+        class PackedTuple
+        {
+            using Layout = PackedLayout<Fields...>;
+
+        public:
+            using Word = typename Layout::Word;
+            constexpr static size_t value = sizeof...(Fields);
+
+            constexpr PackedTuple() = default;
+
+            constexpr explicit PackedTuple(typename Fields::Type... values)
+            {
+                [&]<size_t... index>(std::index_sequence<index...>)
+                {
+                    (Set<index>(values), ...);
+                }(std::make_index_sequence<sizeof...(Fields)>());
+            }
+
+            template <size_t index>
+            constexpr auto Get() const noexcept
+            {
+                using Field = typename TypeAt<index, Fields...>::Type;
+                using T = typename Field::Type;
+                using Integer = Underlying<T>;
+                constexpr size_t word = Layout::positions.word[index];
+                constexpr size_t shift = Layout::positions.shift[index];
+
+                Integer result = static_cast<Integer>((_words[word] >> shift) & Mask<Field::bits>());
+                if constexpr (std::is_signed_v<Integer> && Field::bits < sizeof(Integer) * CHAR_BIT)
+                {
+                    /// Расширение знака: старший бит поля копируется в старшие биты результата
+                    constexpr Integer sign = Integer(1) << (Field::bits - 1);
+                    result = Integer((result ^ sign) - sign);
+                }
+                return static_cast<T>(result);
+            }
+
+            template <size_t index>
+            constexpr void Set(typename TypeAt<index, Fields...>::Type::Type value) noexcept
+            {
+                using Field = typename TypeAt<index, Fields...>::Type;
+                constexpr size_t word = Layout::positions.word[index];
+                constexpr size_t shift = Layout::positions.shift[index];
+                constexpr Word mask = Word(Mask<Field::bits>() << shift);
+
+                const Word bits = Word(Word(static_cast<Underlying<typename Field::Type>>(value)) << shift);
+                _words[word] = Word((_words[word] & ~mask) | (bits & mask));
+            }
+
+            constexpr size_t Size() const { return value; }
+
+            constexpr bool operator==(const PackedTuple&) const = default;
+
+        private:
+            template <typename T>
+            using Underlying = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::type_identity<T>>::type;
+
+            template <size_t bits>
+            constexpr static uint64_t Mask() noexcept
+            {
+                return bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+            }
+
+        private:
+            std::array<Word, Layout::positions.words> _words{};
+        };
+
+        template <size_t index, typename... Fields>
+        constexpr auto Get(const PackedTuple<Fields...>& tuple) noexcept
+        {
+            return tuple.template Get<index>();
+        }
+
+        template <size_t index, typename... Fields, typename T>
+        constexpr void Set(PackedTuple<Fields...>& tuple, T value) noexcept
+        {
+            tuple.template Set<index>(value);
+        }
+
+        /// Structured binding: auto [a, b, c] = packed; - элементы возвращаются по значению (ссылку на битовое поле получить нельзя)
+        template <size_t index, typename... Fields>
+        constexpr auto get(const PackedTuple<Fields...>& tuple) noexcept
+        {
+            return tuple.template Get<index>();
+        }
+    }
+
+    template <typename... Fields, typename... Ts>
+    struct Rebind<packed::PackedTuple<Fields...>, Ts...>
+    {
+        using Type = third_implementation::Tuple<Ts...>;
+    };
+}
+
+namespace std
+{
+    template <typename... Fields>
+    struct tuple_size<::tuple::packed::PackedTuple<Fields...>> : integral_constant<size_t, sizeof...(Fields)> {};
+
+    template <size_t index, typename... Fields>
+    struct tuple_element<index, ::tuple::packed::PackedTuple<Fields...>>
+    {
+        using type = typename ::tuple::TypeAt<index, Fields...>::Type::Type;
+    };
+}
+
+#endif /* PackedTuple_h */
@@ -0,0 +1,151 @@
+#ifndef Record_h
+#define Record_h
+
+#include "Tuple.h"
+#include "TupleAlgorithm.h"
+
+#include <algorithm>
+#include <string_view>
+
+/*
+ Record - tuple с именованными полями: Record<Field<"id", int>, Field<"name", std::string>>.
+ Имя поля - строковый литерал в non-type template параметре (C++20: класс FixedString в качестве шаблонного параметра).
+ Get<"name">(record) находит индекс поля во время компиляции и возвращает ссылку на лист TupleLeaf - это прямой доступ к члену, как Get<1>(tuple), без поиска строки и без хранения имен в объекте.
+ Поля хранятся в листьях TupleLeaf из third_implementation (Record наследует TupleBaseImpl), поэтому работают Get<index>, structured binding и алгоритмы из TupleAlgorithm.h.
+ Transform, Zip и TupleCat возвращают обычный Tuple: число элементов результата может не совпадать с числом полей, а у склеенных записей имена могут повторяться.
+ */
+
+namespace tuple
+{
+    namespace record
+    {
+        /// Строковый литерал как non-type template параметр: "name" -> FixedString<5>
+        template <size_t N>
+        struct FixedString
+        {
+            constexpr FixedString(const char (&string)[N])
+            {
+                std::copy_n(string, N, data);
+            }
+
+            constexpr std::string_view View() const { return std::string_view(data, N - 1); }
+
+            template <size_t M>
+            constexpr bool operator==(const FixedString<M>& other) const { return View() == other.View(); }
+
+            char data[N]{};
+        };
+
+        template <FixedString name, typename T>
+        struct Field
+        {
+            using Type = T;
+            constexpr static auto key = name;
+        };
+
+        /// Индекс поля с именем name, sizeof...(Fields) - если поля нет
+        template <FixedString name, typename... Fields>
+        constexpr size_t FieldIndex = []
+        {
+            constexpr bool found[] = {(Fields::key == name)..., false};
+            return size_t(std::find(std::begin(found), std::end(found), true) - std::begin(found));
+        }();
+
+        template <typename... Fields>
+        struct Record : third_implementation::TupleBaseImpl<third_implementation::MakeIndexSequence<sizeof...(Fields)>, typename Fields::Type...>
+        {
+            using Base = third_implementation::TupleBaseImpl<third_implementation::MakeIndexSequence<sizeof...(Fields)>, typename Fields::Type...>;
+
+            static_assert([]
+            {
+                constexpr std::string_view keys[] = {Fields::key.View()..., std::string_view()};
+                for (size_t i = 0; i < sizeof...(Fields); ++i)
+                {
+                    for (size_t j = i + 1; j < sizeof...(Fields); ++j)
+                    {
+                        if (keys[i] == keys[j])
+                            return false;
+                    }
+                }
+                return true;
+            }(), "field names must be unique");
+
+            constexpr Record() : Base() {}
+            constexpr explicit Record(typename third_implementation::TupleTraits<typename Fields::Type>::ParamType... args) : Base(args...) {}
+
+            /// Идеальная передача (perfect forwarding): временные объекты перемещаются в поля
+            template <typename... UArgs>
+            requires (sizeof...(Fields) > 0 && sizeof...(UArgs) == sizeof...(Fields) && (std::is_constructible_v<typename Fields::Type, UArgs&&> && ...) &&
+                      !(sizeof...(UArgs) == 1 && (std::is_same_v<std::remove_cvref_t<UArgs>, Record> && ...)))
+            constexpr explicit Record(UArgs&&... args) : Base(third_implementation::ForwardTag(), std::forward<UArgs>(args)...) {}
+
+            /// Имена полей по порядку объявления
+            constexpr static std::array<std::string_view, sizeof...(Fields)> names = {Fields::key.View()...};
+            constexpr static size_t value = sizeof...(Fields);
+        };
+
+        /// Get по имени поля: индекс вычисляется во время компиляции, доступ - как Get<index>
+        template <FixedString name, typename... Fields>
+        constexpr auto& Get(Record<Fields...>& record) noexcept
+        {
+            constexpr size_t index = FieldIndex<name, Fields...>;
+            static_assert(index < sizeof...(Fields), "no field with this name");
+            return third_implementation::Get<index>(record);
+        }
+
+        template <FixedString name, typename... Fields>
+        constexpr const auto& Get(const Record<Fields...>& record) noexcept
+        {
+            constexpr size_t index = FieldIndex<name, Fields...>;
+            static_assert(index < sizeof...(Fields), "no field with this name");
+            return third_implementation::Get<index>(record);
+        }
+
+        template <FixedString name, typename... Fields>
+        constexpr auto&& Get(Record<Fields...>&& record) noexcept
+        {
+            constexpr size_t index = FieldIndex<name, Fields...>;
+            static_assert(index < sizeof...(Fields), "no field with this name");
+            return third_implementation::Get<index>(std::move(record));
+        }
+
+        /// Get по индексу и structured binding (auto [id, name] = record)
+        template <size_t index, typename... Fields>
+        constexpr auto& Get(Record<Fields...>& record) noexcept { return third_implementation::Get<index>(record); }
+
+        template <size_t index, typename... Fields>
+        constexpr const auto& Get(const Record<Fields...>& record) noexcept { return third_implementation::Get<index>(record); }
+
+        template <size_t index, typename... Fields>
+        constexpr auto&& Get(Record<Fields...>&& record) noexcept { return third_implementation::Get<index>(std::move(record)); }
+
+        template <size_t index, typename... Fields>
+        constexpr decltype(auto) get(Record<Fields...>& record) noexcept { return Get<index>(record); }
+
+        template <size_t index, typename... Fields>
+        constexpr decltype(auto) get(const Record<Fields...>& record) noexcept { return Get<index>(record); }
+
+        template <size_t index, typename... Fields>
+        constexpr decltype(auto) get(Record<Fields...>&& record) noexcept { return Get<index>(std::move(record)); }
+    }
+
+    template <typename... Fields, typename... Ts>
+    struct Rebind<record::Record<Fields...>, Ts...>
+    {
+        using Type = third_implementation::Tuple<Ts...>;
+    };
+}
+
+namespace std
+{
+    template <typename... Fields>
+    struct tuple_size<::tuple::record::Record<Fields...>> : integral_constant<size_t, sizeof...(Fields)> {};
+
+    template <size_t index, typename... Fields>
+    struct tuple_element<index, ::tuple::record::Record<Fields...>>
+    {
+        using type = typename ::tuple::TypeAt<index, Fields...>::Type::Type;
+    };
+}
+
+#endif /* Record_h */
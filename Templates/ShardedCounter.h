@@ -0,0 +1,141 @@
+#ifndef ShardedCounter_h
+#define ShardedCounter_h
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+/*
+ ShardedCounter - счетчик, который увеличивают и уменьшают много потоков одновременно (например, число живых объектов типа).
+ Обычная переменная - гонка данных (data race), один std::atomic - одна линия кэша, которая перебрасывается между ядрами при каждом изменении.
+ Счетчик разбит на shards частей (shard), каждая в своей линии кэша (alignas(64)); поток получает номер части при первом обращении и меняет только ее:
+ - Add - relaxed fetch_add в линии кэша, которую почти всегда использует только этот поток
+ - Count - сумма всех частей: точное значение, если никто не меняет счетчик, иначе - значение в один из моментов изменения
+ Объект может быть создан в одном потоке и уничтожен в другом: части хранят знаковые значения, сумма остается верной.
+ CounterRegistry - реестр всех счетчиков процесса для телеметрии: Dump печатает имя и значение каждого.
+ TypeName - читаемое имя типа для реестра: typeid(T).name() в GCC и Clang - искаженное имя (mangled name), например N4CRTP7DerivedE вместо CRTP::Derived.
+ */
+
+namespace telemetry
+{
+    class ShardedCounter
+    {
+        constexpr static size_t shards = 32;
+
+        struct alignas(64) Shard
+        {
+            std::atomic<int64_t> value = 0;
+        };
+
+    public:
+        constexpr ShardedCounter() noexcept = default;
+
+        ShardedCounter(const ShardedCounter&) = delete;
+        ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+        void Add(int64_t value) noexcept
+        {
+            _shards[ThreadShard()].value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void Increment() noexcept { Add(1); }
+        void Decrement() noexcept { Add(-1); }
+
+        /// Сумма частей; во время изменений из других потоков может быть кратковременно отрицательной
+        int64_t Sum() const noexcept
+        {
+            int64_t sum = 0;
+            for (const Shard& shard : _shards)
+                sum += shard.value.load(std::memory_order_relaxed);
+            return sum;
+        }
+
+        size_t Count() const noexcept
+        {
+            const int64_t sum = Sum();
+            return sum > 0 ? size_t(sum) : 0;
+        }
+
+    private:
+        /// Номер части потока: назначается по кругу при первом обращении (thread_local без динамической инициализации - без проверки guard при каждом доступе)
+        static size_t ThreadShard() noexcept
+        {
+            if (_thread_shard == shards)
+                _thread_shard = _next_shard.fetch_add(1, std::memory_order_relaxed) % shards;
+            return _thread_shard;
+        }
+
+    private:
+        Shard _shards[shards];
+
+        inline static std::atomic<size_t> _next_shard = 0;
+        inline static thread_local size_t _thread_shard = shards;
+    };
+
+    /// GCC и Clang - abi::__cxa_demangle, MSVC - typeid(T).name() уже читаемое ("struct CRTP::Derived")
+    inline std::string TypeName(const std::type_info& type)
+    {
+#if defined(__GNUG__)
+        int status = 0;
+        const std::unique_ptr<char, void (*)(void*)> name(abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free);
+        if (status == 0 && name)
+            return name.get();
+#endif
+        return type.name();
+    }
+
+    class CounterRegistry
+    {
+    public:
+        static CounterRegistry& Instance()
+        {
+            static CounterRegistry registry;
+            return registry;
+        }
+
+        /// Счетчик должен жить до конца программы (static); возвращает true для инициализации static переменной
+        bool Add(std::string name, const ShardedCounter& counter)
+        {
+            std::lock_guard lock(_mutex);
+            _counters.emplace_back(std::move(name), &counter);
+            return true;
+        }
+
+        /// Имена и значения всех счетчиков в порядке регистрации
+        std::vector<std::pair<std::string, size_t>> Snapshot() const
+        {
+            std::lock_guard lock(_mutex);
+            std::vector<std::pair<std::string, size_t>> result;
+            result.reserve(_counters.size());
+            for (const auto& [name, counter] : _counters)
+                result.emplace_back(name, counter->Count());
+            return result;
+        }
+
+        void Dump(std::ostream& stream) const
+        {
+            for (const auto& [name, count] : Snapshot())
+                stream << name << ": " << count << std::endl;
+        }
+
+    private:
+        CounterRegistry() = default;
+
+    private:
+        mutable std::mutex _mutex;
+        std::vector<std::pair<std::string, const ShardedCounter*>> _counters;
+    };
+}
+
+#endif /* ShardedCounter_h */
@@ -0,0 +1,142 @@
+#ifndef SharedTuple_h
+#define SharedTuple_h
+
+#include "Tuple.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+/*
+ SharedTuple - Tuple тривиально копируемых типов, который редко меняет писатель и очень часто читают много потоков.
+ Последовательная блокировка (sequence lock, seqlock):
+ - писатель делает счетчик нечетным, записывает данные, делает счетчик снова четным
+ - читатель запоминает четный счетчик, копирует данные и проверяет, что счетчик не изменился, иначе повторяет чтение
+ Читатели ничего не записывают в общую память: в отличие от std::mutex и std::shared_mutex, линия кэша не перебрасывается между ядрами и чтение масштабируется по числу потоков.
+ Писатели не ждут читателей, поэтому копия может быть прочитана несколько раз, пока идет запись - подходит только для тривиально копируемых типов небольшого размера.
+ Данные хранятся как массив std::atomic слов и копируются relaxed операциями - одновременное чтение и запись не являются гонкой данных (data race) с точки зрения модели памяти C++.
+ */
+
+namespace tuple
+{
+    namespace third_implementation
+    {
+        template <typename... Ts>
+        class alignas(64) SharedTuple // Выравнивание по линии кэша: запись соседних объектов не сбрасывает кэш читателей
+        {
+        public:
+            using Value = Tuple<Ts...>;
+
+        private:
+            static_assert(std::is_trivially_copyable_v<Value>, "SharedTuple requires trivially copyable types");
+
+            using Word = uintptr_t;
+            constexpr static size_t words = (sizeof(Value) + sizeof(Word) - 1) / sizeof(Word);
+
+        public:
+            SharedTuple() : SharedTuple(Value()) {}
+
+            explicit SharedTuple(const Value& value)
+            {
+                Write(value);
+            }
+
+            SharedTuple(const SharedTuple&) = delete;
+            SharedTuple& operator=(const SharedTuple&) = delete;
+
+            /// Согласованная копия без блокировок: повтор, если во время копирования шла запись
+            Value Load() const noexcept
+            {
+                for (;;)
+                {
+                    const size_t sequence = _sequence.load(std::memory_order_acquire);
+                    if (sequence & 1)
+                    {
+                        std::this_thread::yield(); // Идет запись
+                        continue;
+                    }
+                    const Value value = Read();
+                    std::atomic_thread_fence(std::memory_order_acquire); // Чтение данных не переносится после повторного чтения счетчика
+                    if (_sequence.load(std::memory_order_relaxed) == sequence)
+                        return value;
+                }
+            }
+
+            /// Публикация нового значения; одновременные писатели выполняются по очереди
+            void Store(const Value& value) noexcept
+            {
+                const size_t sequence = Lock();
+                Write(value);
+                _sequence.store(sequence + 2, std::memory_order_release);
+            }
+
+            /// Чтение, изменение и публикация без промежуточной записи другого писателя: Update([](auto& value) { ++Get<0>(value); })
+            /// Исключение из function: данные не меняются, блокировка снимается
+            template <typename TFunction>
+            void Update(TFunction&& function)
+            {
+                const Unlock unlock(_sequence, Lock());
+                Value value = Read();
+                function(value);
+                Write(value);
+            }
+
+        private:
+            /// Счетчик снова четный при выходе из Update, в том числе при исключении: иначе читатели и писатели ждали бы бесконечно
+            class Unlock
+            {
+            public:
+                Unlock(std::atomic<size_t>& sequence, size_t locked) noexcept : _sequence(sequence), _locked(locked) {}
+                ~Unlock() { _sequence.store(_locked + 2, std::memory_order_release); }
+
+                Unlock(const Unlock&) = delete;
+                Unlock& operator=(const Unlock&) = delete;
+
+            private:
+                std::atomic<size_t>& _sequence;
+                const size_t _locked;
+            };
+
+            /// Счетчик становится нечетным - читатели повторят чтение, остальные писатели ждут
+            size_t Lock() noexcept
+            {
+                size_t sequence = _sequence.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    if (!(sequence & 1) && _sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                        break;
+                    std::this_thread::yield();
+                    sequence = _sequence.load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_release); // Запись данных не переносится до нечетного счетчика
+                return sequence;
+            }
+
+            /// Копия данных relaxed чтениями слов, согласованность проверяет вызывающий
+            Value Read() const noexcept
+            {
+                Word buffer[words];
+                for (size_t i = 0; i < words; ++i)
+                    buffer[i] = _data[i].load(std::memory_order_relaxed);
+                Value value;
+                std::memcpy(static_cast<void*>(&value), buffer, sizeof(Value));
+                return value;
+            }
+
+            void Write(const Value& value) noexcept
+            {
+                Word buffer[words] = {};
+                std::memcpy(buffer, static_cast<const void*>(&value), sizeof(Value));
+                for (size_t i = 0; i < words; ++i)
+                    _data[i].store(buffer[i], std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<size_t> _sequence = 0;
+            std::atomic<Word> _data[words];
+        };
+    }
+}
+
+#endif /* SharedTuple_h */
@@ -0,0 +1,181 @@
+#ifndef Signal_h
+#define Signal_h
+
+#include "Callback.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ Signal<Args...> - рассылка одного события многим подписчикам (signal/slot): signal.Connect<&Example::Method1>(example); signal.Emit(true).
+ Слоты - Delegate (2 машинных слова), хранятся подряд в std::vector: Emit - проход по непрерывному массиву.
+ Копирование при записи (copy-on-write): Connect и Disconnect создают новую копию списка и публикуют ее атомарной заменой указателя.
+ Emit не берет блокировку: читает текущий список и вызывает слоты, пока другие потоки подключаются и отключаются.
+ Старый список освобождается, когда его гарантированно никто не читает - две фазы счетчиков читателей (как в RCU, read-copy-update):
+ - читатель увеличивает счетчик текущей эпохи (четной или нечетной) на время Emit
+ - писатель публикует новый список под блокировкой, отпускает ее, переключает эпоху и ждет обнуления счетчика предыдущей эпохи - дважды, чтобы дождаться читателей обеих эпох
+ Ожидание читателей идет без блокировки писателей: слот, который во время Emit подписывается, пока другой поток ждет этот Emit, не блокируется.
+ Connect и Disconnect из слота (любого Signal) во время Emit в том же потоке не ждут (ожидание себя - взаимная блокировка): старый список освобождается при следующей записи.
+ Запись - O(n) копирование и ожидание читателей: Signal подходит, когда Emit часто, а подписка редко.
+ */
+
+namespace callback
+{
+    /// Вложенность Emit любого Signal в текущем потоке: слот, изменяющий другой Signal, тоже не ждет читателей (два потока ждали бы друг друга)
+    inline thread_local size_t emitting = 0;
+
+    template <typename... Args>
+    class Signal
+    {
+    public:
+        using Slot = Delegate<void(Args...)>;
+        using Connection = uint64_t; // 0 - нет подключения
+
+    private:
+        struct Entry
+        {
+            Connection connection;
+            Slot slot;
+        };
+
+        using List = std::vector<Entry>;
+
+        /// Счетчик читателей эпохи на время Emit: эпоха проверяется повторно после увеличения, иначе писатель мог уже переключить ее и не ждать
+        class Reader
+        {
+        public:
+            explicit Reader(const Signal& signal) noexcept : _signal(signal)
+            {
+                for (;;)
+                {
+                    _epoch = _signal._epoch.load();
+                    _signal._readers[_epoch].fetch_add(1);
+                    if (_signal._epoch.load() == _epoch)
+                        break;
+                    _signal._readers[_epoch].fetch_sub(1);
+                }
+                ++emitting;
+            }
+
+            ~Reader()
+            {
+                --emitting;
+                _signal._readers[_epoch].fetch_sub(1);
+            }
+
+        private:
+            const Signal& _signal;
+            size_t _epoch;
+        };
+
+    public:
+        Signal() : _list(new List()) {}
+
+        Signal(const Signal&) = delete;
+        Signal& operator=(const Signal&) = delete;
+
+        /// Одновременный Emit во время уничтожения не допускается
+        ~Signal()
+        {
+            delete _list.load();
+        }
+
+        Connection Connect(Slot slot)
+        {
+            std::unique_lock lock(_mutex);
+            const List& current = *_list.load();
+            auto list = std::make_unique<List>();
+            list->reserve(current.size() + 1);
+            list->assign(current.begin(), current.end());
+            const Connection connection = ++_connections;
+            list->push_back(Entry{connection, slot});
+            Publish(lock, std::move(list));
+            return connection;
+        }
+
+        /// Connect<&Example::Method1>(example): объект не копируется и должен жить, пока подключен
+        template <auto Method, class TClass>
+        Connection Connect(TClass& iClass)
+        {
+            return Connect(Slot::template Bind<Method>(iClass));
+        }
+
+        bool Disconnect(Connection connection)
+        {
+            std::unique_lock lock(_mutex);
+            const List& current = *_list.load();
+            const auto found = std::find_if(current.begin(), current.end(), [connection](const Entry& entry) { return entry.connection == connection; });
+            if (found == current.end())
+                return false;
+            auto list = std::make_unique<List>();
+            list->reserve(current.size() - 1);
+            list->insert(list->end(), current.begin(), found);
+            list->insert(list->end(), found + 1, current.end());
+            Publish(lock, std::move(list));
+            return true;
+        }
+
+        void DisconnectAll()
+        {
+            std::unique_lock lock(_mutex);
+            Publish(lock, std::make_unique<List>());
+        }
+
+        /// Вызов всех слотов по порядку подключения без блокировки; аргументы передаются каждому слоту
+        void Emit(Args... args) const
+        {
+            Reader reader(*this);
+            for (const Entry& entry : *_list.load())
+                entry.slot(args...);
+        }
+
+        size_t Size() const
+        {
+            std::lock_guard lock(_mutex);
+            return _list.load()->size();
+        }
+
+    private:
+        /// Замена списка под lock; ожидание читателей и освобождение старых списков - после снятия lock
+        void Publish(std::unique_lock<std::mutex>& lock, std::unique_ptr<List> list)
+        {
+            _retired.emplace_back(_list.exchange(list.release()));
+            if (emitting != 0)
+                return; // Запись из слота: ожидание читателей включало бы этот же поток
+            std::vector<std::unique_ptr<List>> retired = std::move(_retired); // Все списки сняты с публикации до начала ожидания
+            _retired.clear();
+            lock.unlock();
+            Synchronize();
+        }
+
+        /// Каждая фаза: новые читатели попадают в другую эпоху, ожидаются только начавшие раньше.
+        /// Писатели ожидают по очереди: одновременное переключение эпохи двумя писателями пропустило бы читателей одной из эпох
+        void Synchronize() const
+        {
+            std::lock_guard lock(_synchronize);
+            for (int phase = 0; phase < 2; ++phase)
+            {
+                const size_t epoch = _epoch.load();
+                _epoch.store(epoch ^ 1);
+                while (_readers[epoch].load() != 0)
+                    std::this_thread::yield();
+            }
+        }
+
+    private:
+        std::atomic<List*> _list;
+        mutable std::atomic<size_t> _epoch = 0;
+        alignas(64) mutable std::atomic<size_t> _readers[2] = {}; // Отдельная линия кэша: запись читателей не сбрасывает из кэша указатель на список
+        alignas(64) mutable std::mutex _mutex;                    // Писатели изменяют список по очереди
+        mutable std::mutex _synchronize;                          // Ожидание читателей, без _mutex
+        std::vector<std::unique_ptr<List>> _retired;              // Замененные списки, которые еще могут читать
+        Connection _connections = 0;
+    };
+}
+
+#endif /* Signal_h */
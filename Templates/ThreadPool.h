@@ -0,0 +1,399 @@
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include "Callback.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/*
+ ThreadPool - пул потоков с перехватом работы (work stealing) для задач-callback.
+ У каждого рабочего потока своя очередь (deque):
+ - задачи, поставленные из рабочего потока, кладутся в его очередь и берутся с того же конца (LIFO) - данные задачи еще в кэше
+ - задачи из внешних потоков раздаются по очередям по кругу (round-robin)
+ - поток без работы крадет задачу с другого конца (FIFO) чужой очереди
+ В отличие от одной общей очереди под одним mutex, потоки в основном работают со своими очередями, и блокировка одной очереди почти не конкурентна.
+ Submit возвращает TaskHandle: Get() ждет результат и пробрасывает исключение задачи; ожидание в рабочем потоке выполняет другие задачи, поэтому вложенные Submit/ParallelFor не блокируют пул.
+ Shutdown (и деструктор) выполняет все поставленные задачи и завершает потоки.
+ Исключение задачи Post перехватывается в рабочем потоке и учитывается в Failed(): у Post нет TaskHandle, через который его можно пробросить.
+ */
+
+namespace callback
+{
+    class ThreadPool;
+
+    /// Общее состояние задачи и TaskHandle: результат или исключение
+    template <typename T>
+    struct TaskState
+    {
+        std::mutex mutex;
+        std::condition_variable ready_condition;
+        std::atomic<bool> ready = false;
+        std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+        std::exception_ptr exception;
+    };
+
+    template <typename T>
+    class TaskHandle
+    {
+        friend class ThreadPool;
+
+    public:
+        TaskHandle() = default;
+
+        bool Ready() const noexcept { return _state && _state->ready.load(std::memory_order_acquire); }
+
+        /// Ожидание: рабочий поток пула выполняет другие задачи, внешний поток спит
+        void Wait() const;
+
+        T Get()
+        {
+            Wait();
+            if (_state->exception)
+                std::rethrow_exception(_state->exception);
+            if constexpr (!std::is_void_v<T>)
+                return std::move(*_state->value);
+        }
+
+    private:
+        TaskHandle(ThreadPool* pool, std::shared_ptr<TaskState<T>> state) : _pool(pool), _state(std::move(state)) {}
+
+    private:
+        ThreadPool* _pool = nullptr;
+        std::shared_ptr<TaskState<T>> _state;
+    };
+
+    class ThreadPool
+    {
+        /// Задача: функция с результатом и shared_ptr на состояние помещаются во внутренний буфер без дополнительного выделения памяти
+        using Task = InplaceCallback<void(), 8 * sizeof(void*)>;
+        constexpr static size_t task_capacity = 8 * sizeof(void*);
+
+        struct alignas(64) Worker // Выравнивание по линии кэша: очереди соседних потоков не делят линию кэша (false sharing)
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+    public:
+        explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency())) :
+        _workers(threads)
+        {
+            _threads.reserve(threads);
+            for (size_t index = 0; index < threads; ++index)
+                _threads.emplace_back([this, index]() { Run(index); });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            Shutdown();
+        }
+
+        size_t Size() const noexcept { return _workers.size(); }
+
+        /// Submit([]() { return 42; }).Get() == 42
+        /// Функция с захватом больше буфера задачи (около 48 байт вместе с состоянием) хранится в куче: 1 дополнительное выделение памяти
+        template <typename TFunction>
+        auto Submit(TFunction&& function) -> TaskHandle<std::invoke_result_t<std::decay_t<TFunction>&>>
+        {
+            using TResult = std::invoke_result_t<std::decay_t<TFunction>&>;
+            auto state = std::make_shared<TaskState<TResult>>();
+            Push(MakeTask([state, function = std::forward<TFunction>(function)]() mutable
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<TResult>)
+                    {
+                        function();
+                        state->value.emplace(true);
+                    }
+                    else
+                    {
+                        state->value.emplace(function());
+                    }
+                }
+                catch (...)
+                {
+                    state->exception = std::current_exception();
+                }
+                {
+                    std::lock_guard lock(state->mutex);
+                    state->ready.store(true, std::memory_order_release);
+                }
+                state->ready_condition.notify_all();
+            }));
+            return TaskHandle<TResult>(this, std::move(state));
+        }
+
+        /// Задача-callback без результата: Post(InplaceCallback<void()>(example, &Example::Method1, true))
+        void Post(InplaceCallback<void()>&& callback)
+        {
+            Push(Task([this, callback = std::move(callback)]() mutable { Invoke(callback); }));
+        }
+
+        void Post(std::unique_ptr<ICallback> callback)
+        {
+            Push(Task([this, callback = std::move(callback)]() { Invoke(*callback); }));
+        }
+
+        /// Число задач Post, завершившихся исключением
+        size_t Failed() const noexcept { return _failed.load(std::memory_order_relaxed); }
+
+        /*
+         function(index) для каждого index из [begin, end): диапазон делится на блоки по grain индексов, блоки разбирают рабочие потоки и вызывающий поток.
+         Возврат - после выполнения всех блоков, исключение первого упавшего блока пробрасывается.
+         */
+        template <typename TFunction>
+        void ParallelFor(size_t begin, size_t end, TFunction&& function, size_t grain = 1)
+        {
+            if (begin >= end)
+                return;
+            grain = std::max<size_t>(grain, 1);
+            const size_t blocks = (end - begin + grain - 1) / grain;
+
+            std::atomic<size_t> next = 0;
+            auto run_blocks = [&]()
+            {
+                for (size_t block = next.fetch_add(1); block < blocks; block = next.fetch_add(1))
+                {
+                    const size_t first = begin + block * grain;
+                    const size_t last = std::min(end, first + grain);
+                    for (size_t index = first; index < last; ++index)
+                        function(index);
+                }
+            };
+
+            std::vector<TaskHandle<void>> helpers;
+            const size_t helpers_count = std::min(blocks, Size()) - 1;
+            helpers.reserve(helpers_count);
+            for (size_t i = 0; i < helpers_count; ++i)
+                helpers.push_back(Submit(run_blocks));
+            /// Локальные переменные нужны помощникам до их завершения: исключение пробрасывается только после ожидания всех
+            std::exception_ptr exception;
+            try
+            {
+                run_blocks();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+                next = blocks; // Оставшиеся блоки не выполняются
+            }
+            for (auto& helper : helpers)
+            {
+                try
+                {
+                    helper.Get();
+                }
+                catch (...)
+                {
+                    if (!exception)
+                        exception = std::current_exception();
+                }
+            }
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+
+        /// Выполняет все поставленные задачи и завершает потоки; Submit после Shutdown - исключение
+        void Shutdown()
+        {
+            {
+                std::lock_guard lock(_sleep_mutex);
+                if (_stop)
+                    return;
+                _stop = true;
+            }
+            _sleep_condition.notify_all();
+            for (auto& thread : _threads)
+                thread.join();
+        }
+
+        /// Выполнить одну задачу в текущем потоке, если она есть (используется при ожидании)
+        bool RunOne()
+        {
+            if (std::optional<Task> task = Take(CurrentWorker()))
+            {
+                (*task)();
+                return true;
+            }
+            return false;
+        }
+
+        /// Текущий поток - рабочий поток этого пула
+        bool IsWorker() const noexcept { return _current_pool == this; }
+
+    private:
+        template <typename TFunction>
+        static Task MakeTask(TFunction&& function)
+        {
+            if constexpr (sizeof(TFunction) <= task_capacity && alignof(TFunction) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<TFunction>)
+                return Task(std::move(function));
+            else
+                return Task([function = std::make_unique<TFunction>(std::move(function))]() { (*function)(); });
+        }
+
+        template <typename TCallable>
+        void Invoke(TCallable& callable) noexcept
+        {
+            try
+            {
+                callable();
+            }
+            catch (...)
+            {
+                _failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void Push(Task&& task)
+        {
+            /// Счетчик _pushing виден потокам до проверки _stop: поток не завершится, пока задача, прошедшая проверку, не попала в очередь
+            _pushing.fetch_add(1);
+            if (_stop)
+            {
+                _pushing.fetch_sub(1);
+                throw std::runtime_error("ThreadPool is shut down");
+            }
+
+            const size_t index = IsWorker() ? _current_worker : _next_worker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+            {
+                std::lock_guard lock(_workers[index].mutex);
+                _workers[index].tasks.push_back(std::move(task));
+            }
+            _pending.fetch_add(1);
+            _pushing.fetch_sub(1);
+            /// Будится 1 спящий поток, даже если другие заняты: занятый поток может выполнять долгую задачу, а новая задача лежит в его очереди.
+            /// Проснувшийся поток сам будит следующий, если задач больше одной
+            if (_sleeping.load() > 0)
+                WakeOne();
+        }
+
+        void WakeOne()
+        {
+            std::lock_guard lock(_sleep_mutex); // Без блокировки поток мог бы проверить _pending и заснуть между fetch_add и notify
+            _sleep_condition.notify_one();
+        }
+
+        /// Своя очередь - с конца (LIFO), чужие - с начала (FIFO)
+        std::optional<Task> Take(size_t own)
+        {
+            if (_pending.load(std::memory_order_relaxed) == 0)
+                return std::nullopt;
+
+            const size_t size = _workers.size();
+            for (size_t offset = 0; offset < size; ++offset)
+            {
+                const size_t index = (own + offset) % size;
+                Worker& worker = _workers[index];
+                std::unique_lock lock(worker.mutex, std::try_to_lock);
+                if (!lock.owns_lock())
+                {
+                    if (offset != 0)
+                        continue; // Чужая очередь занята - следующая
+                    lock.lock();
+                }
+                if (worker.tasks.empty())
+                    continue;
+
+                std::optional<Task> task;
+                if (offset == 0 && IsWorker())
+                {
+                    task.emplace(std::move(worker.tasks.back()));
+                    worker.tasks.pop_back();
+                }
+                else
+                {
+                    task.emplace(std::move(worker.tasks.front()));
+                    worker.tasks.pop_front();
+                }
+                _pending.fetch_sub(1);
+                return task;
+            }
+            return std::nullopt;
+        }
+
+        size_t CurrentWorker() const noexcept
+        {
+            return IsWorker() ? _current_worker : 0;
+        }
+
+        void Run(size_t index)
+        {
+            _current_pool = this;
+            _current_worker = index;
+            for (;;)
+            {
+                if (std::optional<Task> task = Take(index))
+                {
+                    if (_pending.load() > 0 && _sleeping.load() > 0)
+                        WakeOne(); // Остались задачи - помощь следующего потока
+                    (*task)();
+                    continue;
+                }
+
+                std::unique_lock lock(_sleep_mutex);
+                ++_sleeping;
+                _sleep_condition.wait(lock, [this]() { return _stop || _pending.load() > 0; });
+                --_sleeping;
+                if (_stop)
+                {
+                    /// _pushing читается до _pending: если Push уже завершился, его задача видна в _pending
+                    if (_pushing.load() == 0 && _pending.load() == 0)
+                        return;
+                    if (_pending.load() == 0)
+                    {
+                        lock.unlock();
+                        std::this_thread::yield(); // Push между проверкой _stop и очередью - задача появится через несколько инструкций
+                    }
+                }
+            }
+        }
+
+    private:
+        std::vector<Worker> _workers;
+        std::vector<std::thread> _threads;
+        std::atomic<size_t> _next_worker = 0;
+        std::atomic<size_t> _pending = 0;  // Задачи во всех очередях
+        std::atomic<size_t> _sleeping = 0; // Спящие рабочие потоки
+        std::atomic<size_t> _pushing = 0;  // Push между проверкой _stop и добавлением в очередь
+        std::atomic<size_t> _failed = 0;   // Задачи Post, завершившиеся исключением
+        std::mutex _sleep_mutex;
+        std::condition_variable _sleep_condition;
+        std::atomic<bool> _stop = false;
+
+        inline static thread_local const ThreadPool* _current_pool = nullptr;
+        inline static thread_local size_t _current_worker = 0;
+    };
+
+    template <typename T>
+    void TaskHandle<T>::Wait() const
+    {
+        if (_pool && _pool->IsWorker())
+        {
+            while (!Ready())
+            {
+                if (!_pool->RunOne())
+                    std::this_thread::yield();
+            }
+            return;
+        }
+
+        std::unique_lock lock(_state->mutex);
+        _state->ready_condition.wait(lock, [this]() { return _state->ready.load(std::memory_order_acquire); });
+    }
+}
+
+#endif /* ThreadPool_h */
@@ -0,0 +1,406 @@
+#ifndef TimerWheel_h
+#define TimerWheel_h
+
+#include "Callback.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ TimerWheel - иерархическое колесо таймеров (hierarchical timing wheel) для отложенных и периодических callback.
+ Время делится на тики (tick), колесо состоит из levels уровней по 256 ячеек: ячейка уровня 0 - 1 тик, уровня 1 - 256 тиков, уровня 2 - 65536 тиков и т.д.
+ - Schedule: уровень и ячейка вычисляются из оставшегося времени, таймер добавляется в двусвязный список ячейки - O(1)
+ - Cancel: удаление из двусвязного списка по TimerId - O(1)
+ - каждый тик выполняются таймеры текущей ячейки уровня 0; когда индекс уровня 0 проходит круг, таймеры следующей ячейки уровня 1 раскладываются (cascade) по уровню 0, и т.д.
+ В отличие от кучи (std::priority_queue, std::multimap) с O(log n) на постановку и отмену, стоимость не зависит от числа таймеров.
+ Таймеры лежат в блоках по 1024 узла (адреса стабильны, индекс - сдвиг и маска) и связаны индексами; освобожденные узлы переиспользуются.
+ Периодический таймер после срабатывания переставляется в колесо тем же узлом: без выделения памяти.
+ Управление:
+ - Start() запускает поток-драйвер, который продвигает колесо по steady_clock и вызывает callback
+ - Advance(ticks) продвигает колесо вручную (если поток-драйвер не запущен)
+ Callback вызываются без блокировки: внутри callback можно вызывать Schedule и Cancel.
+ */
+
+namespace callback
+{
+    class TimerWheel
+    {
+        using Task = InplaceCallback<void()>;
+
+        constexpr static size_t bits = 8;
+        constexpr static size_t slots = size_t(1) << bits;
+        constexpr static size_t levels = 4; // 2^32 тиков, более поздние таймеры - в последней ячейке и раскладываются повторно
+        constexpr static uint32_t none = UINT32_MAX;
+        constexpr static size_t chunk_bits = 10;
+        constexpr static size_t chunk_size = size_t(1) << chunk_bits;
+
+        enum class State : uint8_t
+        {
+            Free,
+            Scheduled,
+            Running
+        };
+
+        struct Node
+        {
+            Task callback;
+            uint64_t expires = 0; // Тик срабатывания
+            uint64_t period = 0;  // Тиков между срабатываниями, 0 - однократный таймер
+            uint32_t previous = none;
+            uint32_t next = none;
+            uint32_t generation = 0;
+            uint16_t slot = 0; // level * slots + индекс ячейки
+            State state = State::Free;
+            bool cancelled = false;
+        };
+
+        struct Expired
+        {
+            uint32_t index;
+            Node* node;
+        };
+
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// Идентификатор для отмены: устаревший идентификатор (таймер сработал или отменен) не отменяет новый таймер в том же узле
+        struct TimerId
+        {
+            uint32_t index = none;
+            uint32_t generation = 0;
+
+            bool operator==(const TimerId&) const = default;
+        };
+
+        explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(1)) : _tick(tick)
+        {
+            _heads.fill(none);
+        }
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        ~TimerWheel()
+        {
+            Stop();
+        }
+
+        /// callback через delay, затем каждые period (0 - однократно): Schedule(100ms, InplaceCallback<void()>(&example, &Example::Method1, true))
+        TimerId Schedule(Clock::duration delay, Task&& callback, Clock::duration period = Clock::duration::zero())
+        {
+            std::unique_lock lock(_mutex);
+            const uint32_t index = Allocate();
+            Node& node = At(index);
+            node.callback = std::move(callback);
+            if (_count == 0 && _driving) // Пустое колесо не продвигается потоком-драйвером: время сдвигается по часам до постановки
+                _current = Next();
+            node.expires = Next() + Ticks(delay);
+            node.period = period > Clock::duration::zero() ? std::max<uint64_t>(Ticks(period), 1) : 0;
+            node.state = State::Scheduled;
+            node.cancelled = false;
+            Link(index);
+            const TimerId id{index, node.generation};
+            const bool was_empty = _count++ == 0;
+            lock.unlock();
+            if (was_empty)
+                _condition.notify_one(); // Поток-драйвер спит без таймаута, пока колесо пустое
+            return id;
+        }
+
+        TimerId Schedule(Clock::duration delay, std::unique_ptr<ICallback> callback, Clock::duration period = Clock::duration::zero())
+        {
+            return Schedule(delay, Task([callback = std::move(callback)]() { (*callback)(); }), period);
+        }
+
+        /// false - таймер уже сработал или отменен; выполняющийся сейчас периодический таймер больше не будет переставлен
+        bool Cancel(TimerId id)
+        {
+            Task callback; // Уничтожается после снятия блокировки: деструктор callback может вызвать Cancel
+            std::lock_guard lock(_mutex);
+            if (id.index >= _size)
+                return false;
+            Node& node = At(id.index);
+            if (node.generation != id.generation || node.state == State::Free || node.cancelled)
+                return false;
+            if (node.state == State::Running)
+            {
+                if (node.period == 0)
+                    return false; // Однократный таймер уже выполняется
+                node.cancelled = true;
+                return true;
+            }
+            Unlink(id.index);
+            callback = std::move(node.callback);
+            Release(id.index);
+            return true;
+        }
+
+        /// Ручное продвижение на ticks тиков; возвращает количество вызванных callback
+        size_t Advance(uint64_t ticks = 1)
+        {
+            size_t fired = 0;
+            for (uint64_t i = 0; i < ticks; ++i)
+            {
+                std::unique_lock lock(_mutex);
+                if (_count == 0) // Пустое колесо: раскладывать нечего, время сдвигается сразу
+                {
+                    _current += ticks - i;
+                    break;
+                }
+                fired += ProcessTick(lock);
+            }
+            return fired;
+        }
+
+        /// Запуск потока-драйвера: тики отсчитываются от момента запуска, Schedule отсчитывает delay от текущего момента
+        void Start()
+        {
+            std::lock_guard lock(_mutex);
+            if (_driver.joinable())
+                return;
+            _stop = false;
+            _driving = true;
+            _origin = Clock::now();
+            _first = _current;
+            _driver = std::thread([this]() { Drive(); });
+        }
+
+        /// Остановка потока-драйвера; таймеры остаются в колесе
+        void Stop()
+        {
+            {
+                std::lock_guard lock(_mutex);
+                if (!_driver.joinable())
+                    return;
+                _stop = true;
+            }
+            _condition.notify_all();
+            _driver.join();
+            std::lock_guard lock(_mutex);
+            _driving = false;
+        }
+
+        /// Количество активных таймеров
+        size_t Size() const
+        {
+            std::lock_guard lock(_mutex);
+            return _count;
+        }
+
+    private:
+        /// Округление вверх: таймер не срабатывает раньше delay
+        uint64_t Ticks(Clock::duration duration) const noexcept
+        {
+            if (duration <= Clock::duration::zero())
+                return 0;
+            return uint64_t((duration + _tick - Clock::duration(1)) / _tick);
+        }
+
+        /// Тик, который обрабатывается следующим: с потоком-драйвером - по часам (пустое колесо стоит, занятое может отставать на время callback), иначе - _current
+        uint64_t Next() const
+        {
+            if (!_driving)
+                return _current;
+            return std::max(_current, _first + uint64_t((Clock::now() - _origin) / _tick) + 1);
+        }
+
+        uint32_t Allocate()
+        {
+            if (_free != none)
+            {
+                const uint32_t index = _free;
+                _free = At(index).next;
+                return index;
+            }
+            if (_size == _chunks.size() * chunk_size)
+                _chunks.push_back(std::make_unique<Node[]>(chunk_size));
+            return uint32_t(_size++);
+        }
+
+        Node& At(uint32_t index) noexcept
+        {
+            return _chunks[index >> chunk_bits][index & (chunk_size - 1)];
+        }
+
+        void Release(uint32_t index) noexcept
+        {
+            Node& node = At(index);
+            node.state = State::Free;
+            ++node.generation;
+            node.previous = none;
+            node.next = _free;
+            _free = index;
+            --_count;
+        }
+
+        /// Ячейка по оставшемуся времени: уровень - старший ненулевой байт разницы, индекс - соответствующий байт момента срабатывания
+        void Link(uint32_t index) noexcept
+        {
+            Node& node = At(index);
+            uint64_t expires = node.expires;
+            if (expires < _current) // Опоздавший таймер - в ближайший тик
+                expires = _current;
+            uint64_t delta = expires - _current;
+            constexpr uint64_t max_delta = (uint64_t(1) << (bits * levels)) - 1;
+            if (delta > max_delta) // За пределами колеса: последняя ячейка, при раскладке будет переставлен снова
+            {
+                delta = max_delta;
+                expires = _current + max_delta;
+            }
+
+            size_t level = 0;
+            while (level + 1 < levels && delta >= (uint64_t(1) << (bits * (level + 1))))
+                ++level;
+            const size_t slot = level * slots + size_t((expires >> (bits * level)) & (slots - 1));
+
+            node.slot = uint16_t(slot);
+            node.previous = none;
+            node.next = _heads[slot];
+            if (node.next != none)
+                At(node.next).previous = index;
+            _heads[slot] = index;
+        }
+
+        void Unlink(uint32_t index) noexcept
+        {
+            Node& node = At(index);
+            if (node.previous != none)
+                At(node.previous).next = node.next;
+            else
+                _heads[node.slot] = node.next;
+            if (node.next != none)
+                At(node.next).previous = node.previous;
+        }
+
+        /// Забрать весь список ячейки
+        uint32_t Detach(size_t slot) noexcept
+        {
+            const uint32_t head = _heads[slot];
+            _heads[slot] = none;
+            return head;
+        }
+
+        /// Таймеры ячейки уровня level раскладываются по нижним уровням; возвращает индекс ячейки
+        size_t Cascade(size_t level) noexcept
+        {
+            const size_t index = size_t((_current >> (bits * level)) & (slots - 1));
+            for (uint32_t node = Detach(level * slots + index); node != none;)
+            {
+                const uint32_t next = At(node).next;
+                Link(node);
+                node = next;
+            }
+            return index;
+        }
+
+        /// Один тик: раскладка верхних уровней, затем вызов таймеров текущей ячейки уровня 0 без блокировки
+        size_t ProcessTick(std::unique_lock<std::mutex>& lock)
+        {
+            if ((_current & (slots - 1)) == 0)
+            {
+                for (size_t level = 1; level < levels && Cascade(level) == 0; ++level) {}
+            }
+            uint32_t index = Detach(size_t(_current & (slots - 1)));
+            ++_current;
+            if (index == none)
+                return 0;
+
+            /// Указатели на узлы берутся под блокировкой: блоки узлов не перемещаются, когда Schedule из другого потока добавляет узлы
+            std::vector<Expired> expired;
+            expired.swap(_expired); // Буфер переиспользуется; callback может вызвать Advance - вложенный тик выделит свой
+            expired.clear();
+            for (; index != none; index = At(index).next)
+            {
+                At(index).state = State::Running;
+                expired.push_back(Expired{index, &At(index)});
+            }
+
+            lock.unlock();
+            for (const Expired& timer : expired)
+            {
+                timer.node->callback();
+                if (timer.node->period == 0)
+                    timer.node->callback.Reset(); // Деструктор callback вызывается без блокировки
+            }
+            lock.lock();
+
+            size_t cancelled = 0; // Отмененные во время вызова периодические таймеры - в начале expired
+            for (const Expired& timer : expired)
+            {
+                if (timer.node->period == 0)
+                {
+                    Release(timer.index);
+                }
+                else if (timer.node->cancelled)
+                {
+                    expired[cancelled++] = timer;
+                }
+                else
+                {
+                    timer.node->state = State::Scheduled;
+                    timer.node->expires += timer.node->period; // От предыдущего срабатывания: без накопления задержки
+                    Link(timer.index);
+                }
+            }
+            const size_t fired = expired.size();
+            if (cancelled != 0)
+            {
+                lock.unlock();
+                for (size_t i = 0; i < cancelled; ++i)
+                    expired[i].node->callback.Reset();
+                lock.lock();
+                for (size_t i = 0; i < cancelled; ++i)
+                    Release(expired[i].index);
+            }
+            if (_expired.capacity() < expired.capacity())
+                _expired.swap(expired);
+            return fired;
+        }
+
+        /// Тик target - текущий момент; обработаны все тики <= target, следующий ожидается до момента тика _current
+        void Drive()
+        {
+            std::unique_lock lock(_mutex);
+            while (!_stop)
+            {
+                const uint64_t target = Next() - 1;
+                if (_count == 0) // Пустое колесо: время сдвигается сразу, сон до первого Schedule (Schedule сдвигает время сам)
+                {
+                    _current = target + 1;
+                    _condition.wait(lock, [this]() { return _stop || _count != 0; });
+                    continue;
+                }
+                while (_current <= target && _count != 0 && !_stop)
+                    ProcessTick(lock);
+                if (_current > target)
+                    _condition.wait_until(lock, _origin + _tick * (_current - _first), [this]() { return _stop; });
+            }
+        }
+
+    private:
+        const Clock::duration _tick;
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        std::array<uint32_t, levels * slots> _heads; // Голова двусвязного списка каждой ячейки
+        std::vector<std::unique_ptr<Node[]>> _chunks;
+        size_t _size = 0; // Выделенные узлы
+        std::vector<Expired> _expired;  // Буфер сработавших таймеров одного тика
+        uint32_t _free = none;          // Список свободных узлов (через next)
+        uint64_t _current = 0;          // Следующий тик
+        size_t _count = 0;
+        std::thread _driver;
+        Clock::time_point _origin; // Момент запуска потока-драйвера
+        uint64_t _first = 0;       // Тик в момент запуска
+        bool _driving = false;     // Поток-драйвер запущен: время колеса идет по часам
+        bool _stop = false;
+    };
+}
+
+#endif /* TimerWheel_h */
@@ -1,7 +1,10 @@
 #ifndef Tuple_h
 #define Tuple_h
 
+#include <array>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
 /*
  Сайты: https://www.itcodar.com/c-plus-1/template-tuple-calling-a-function-on-each-element.html
@@ -25,6 +28,49 @@ namespace tuple
 {
     template <std::size_t N> struct dummy{};
 
+    /// Метафункция: тип по индексу index в пачке Args...
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define TUPLE_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+#ifdef TUPLE_TYPE_PACK_ELEMENT
+    /// Builtin компилятора выбирает тип без рекурсии
+    template <size_t index, typename... Args>
+    struct TypeAt
+    {
+        using Type = __type_pack_element<index, Args...>;
+    };
+#else
+    template <size_t index, typename... Args>
+    struct TypeAt;
+
+    template <typename Head, typename... Tail>
+    struct TypeAt<0, Head, Tail...>
+    {
+        using Type = Head;
+    };
+
+    template <size_t index, typename Head, typename... Tail>
+    struct TypeAt<index, Head, Tail...> : TypeAt<index - 1, Tail...> {};
+#endif
+
+    /// Метафункция: индекс типа T в пачке Args..., count - сколько раз T встречается в пачке (для Get<T> должен быть ровно 1 раз)
+    template <typename T, typename... Args>
+    struct TypeIndex
+    {
+        constexpr static size_t count = (0u + ... + size_t(std::is_same_v<T, Args>));
+        constexpr static size_t value = []
+        {
+            constexpr bool matches[] = {std::is_same_v<T, Args>..., false};
+            size_t index = 0;
+            while (index < sizeof...(Args) && !matches[index])
+                ++index;
+            return index;
+        }();
+    };
+
     namespace first_implementation
     {
         /// Stub-функция (заглушка) для рекурсии
@@ -68,7 +114,9 @@ namespace tuple
             Tuple(const Tuple&) = default;
             Tuple(Tuple&&) = default;
             
+            /// Ограничение: шаблонный конструктор не должен перехватывать копирование неконстантного lvalue Tuple
             template<typename UHead, typename ...UTail>
+            requires (sizeof...(UTail) == sizeof...(Tail) && !std::is_same_v<std::remove_cvref_t<UHead>, Tuple>)
             constexpr Tuple(UHead &&head, UTail&& ...tail):
             _head(std::forward<UHead>(head)),
             _tail(std::forward<UTail>(tail)...) {}
@@ -88,7 +136,7 @@ namespace tuple
         {
             template<size_t index, typename H> friend struct GetHelper;
         public:
-            Tuple(const T& value): _head(value)
+            constexpr Tuple(const T& value): _head(value)
             {}
 
             constexpr static size_t value = 1u;
@@ -101,33 +149,102 @@ namespace tuple
         template <size_t index, typename T>
         struct GetHelper;
 
-        /// Частичная специализация для index == 0, возврат только первого члена tuple
+        /// Частичная специализация для index == 0, возврат ссылки на первый член tuple (без копирования)
         template <typename Head, typename... Tail>
         struct GetHelper<0, Tuple<Head, Tail...>>
         {
-            static Head Get(const Tuple<Head, Tail...>& tuple)
+            using Type = Head;
+            
+            constexpr static Head& Get(Tuple<Head, Tail...>& tuple) noexcept
+            {
+                return tuple._head;
+            }
+            
+            constexpr static const Head& Get(const Tuple<Head, Tail...>& tuple) noexcept
             {
                 return tuple._head;
             }
+            
+            constexpr static Head&& Get(Tuple<Head, Tail...>&& tuple) noexcept
+            {
+                return std::forward<Head>(tuple._head);
+            }
         };
 
         /// Метафункция с частичной специализацией для index == n, рекурсионный вызов до n-- > 0
         template <size_t index, typename Head, typename... Tail>
         struct GetHelper<index, Tuple<Head, Tail...>>
         {
-            static auto Get(const Tuple<Head, Tail...>& tuple)
+            using Next = GetHelper<index - 1, Tuple<Tail...>>;
+            using Type = typename Next::Type;
+            
+            constexpr static Type& Get(Tuple<Head, Tail...>& tuple) noexcept
+            {
+                return Next::Get(tuple._tail);
+            }
+            
+            constexpr static const Type& Get(const Tuple<Head, Tail...>& tuple) noexcept
+            {
+                return Next::Get(tuple._tail);
+            }
+            
+            constexpr static Type&& Get(Tuple<Head, Tail...>&& tuple) noexcept
             {
-                return GetHelper<index - 1, Tuple<Tail...>>::Get(tuple._tail);
+                return Next::Get(std::move(tuple._tail));
             }
         };
 
-        // Функция, вызывающая метафункцию
-        template <size_t index, template <typename...> class Tuple, typename... Args>
-        auto Get(const Tuple<Args...>& tuple)
+        /// Функции, вызывающие метафункцию: lvalue, const lvalue и rvalue возвращают ссылку, а не копию элемента
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) Get(Tuple<Args...>& tuple) noexcept
         {
             return GetHelper<index, Tuple<Args...>>::Get(tuple);
         }
 
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) Get(const Tuple<Args...>& tuple) noexcept
+        {
+            return GetHelper<index, Tuple<Args...>>::Get(tuple);
+        }
+
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) Get(Tuple<Args...>&& tuple) noexcept
+        {
+            return GetHelper<index, Tuple<Args...>>::Get(std::move(tuple));
+        }
+
+        /// Get по типу: тип T должен встречаться в tuple ровно 1 раз
+        template <typename T, typename... Args>
+        constexpr decltype(auto) Get(Tuple<Args...>& tuple) noexcept
+        {
+            static_assert(TypeIndex<T, Args...>::count == 1, "type must occur exactly once");
+            return Get<TypeIndex<T, Args...>::value>(tuple);
+        }
+
+        template <typename T, typename... Args>
+        constexpr decltype(auto) Get(const Tuple<Args...>& tuple) noexcept
+        {
+            static_assert(TypeIndex<T, Args...>::count == 1, "type must occur exactly once");
+            return Get<TypeIndex<T, Args...>::value>(tuple);
+        }
+
+        template <typename T, typename... Args>
+        constexpr decltype(auto) Get(Tuple<Args...>&& tuple) noexcept
+        {
+            static_assert(TypeIndex<T, Args...>::count == 1, "type must occur exactly once");
+            return Get<TypeIndex<T, Args...>::value>(std::move(tuple));
+        }
+
+        /// Structured binding (auto [a, b] = tuple) ищет get (в нижнем регистре) через ADL (argument-dependent lookup)
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) get(Tuple<Args...>& tuple) noexcept { return Get<index>(tuple); }
+
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) get(const Tuple<Args...>& tuple) noexcept { return Get<index>(tuple); }
+
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) get(Tuple<Args...>&& tuple) noexcept { return Get<index>(std::move(tuple)); }
+
         template <typename ...Args>
         constexpr Tuple<Args...> Make_Tuple(Args&& ...args)
         {
@@ -155,7 +272,7 @@ namespace tuple
             template<size_t index, typename H, typename... T> friend struct GetHelper;
             
         public:
-            Tuple(Head&& head, Tail&&... tail):
+            constexpr Tuple(Head&& head, Tail&&... tail):
             Tuple<Tail...>(std::forward<Tail>(tail)...),
             _head(std::forward<Head>(head))
             {}
@@ -164,7 +281,9 @@ namespace tuple
             Tuple(Tuple&&) = default;
             
             constexpr Tuple() = default;
+            /// Ограничение: шаблонный конструктор не должен перехватывать копирование неконстантного lvalue Tuple
             template<typename UHead, typename ...UTail>
+            requires (sizeof...(UTail) == sizeof...(Tail) && !std::is_same_v<std::remove_cvref_t<UHead>, Tuple>)
             constexpr Tuple(UHead &&head, UTail&& ...tail):
             Tuple<Tail...>(std::forward<UTail>(tail)...),
             _head(std::forward<UHead>(head))
@@ -184,7 +303,7 @@ namespace tuple
         {
             template<size_t index, typename H, typename... T> friend struct GetHelper;
         public:
-            Tuple(Head head):
+            constexpr Tuple(Head head):
             _head(head)
             {}
             
@@ -200,29 +319,99 @@ namespace tuple
         template<size_t index, typename Head, typename... Tail>
         struct GetHelper
         {
-            static auto value(const Tuple<Head, Tail...>& tuple)
+            using Next = GetHelper<index - 1, Tail...>;
+            using Type = typename Next::Type;
+            
+            constexpr static Type& value(Tuple<Head, Tail...>& tuple) noexcept
             {
-                return GetHelper<index - 1, Tail...>::value(tuple);
+                return Next::value(tuple);
+            }
+            
+            constexpr static const Type& value(const Tuple<Head, Tail...>& tuple) noexcept
+            {
+                return Next::value(tuple);
+            }
+            
+            constexpr static Type&& value(Tuple<Head, Tail...>&& tuple) noexcept
+            {
+                return Next::value(std::move(tuple));
             }
         };
 
         template<typename Head, typename... Tail>
         struct GetHelper<0, Head, Tail...>
         {
-            static Head value(const Tuple<Head, Tail...>& tuple)
+            using Type = Head;
+            
+            constexpr static Head& value(Tuple<Head, Tail...>& tuple) noexcept
             {
                 return tuple._head;
             }
+            
+            constexpr static const Head& value(const Tuple<Head, Tail...>& tuple) noexcept
+            {
+                return tuple._head;
+            }
+            
+            constexpr static Head&& value(Tuple<Head, Tail...>&& tuple) noexcept
+            {
+                return std::forward<Head>(tuple._head);
+            }
         };
 
+        /// lvalue, const lvalue и rvalue возвращают ссылку, а не копию элемента
+        template<size_t index, typename Head, typename... Tail>
+        constexpr decltype(auto) Get(Tuple<Head, Tail...>& tuple) noexcept
+        {
+            return GetHelper<index, Head, Tail...>::value(tuple);
+        }
+
         template<size_t index, typename Head, typename... Tail>
-        auto Get(const Tuple<Head, Tail...>& tuple)
+        constexpr decltype(auto) Get(const Tuple<Head, Tail...>& tuple) noexcept
         {
             return GetHelper<index, Head, Tail...>::value(tuple);
         }
 
+        template<size_t index, typename Head, typename... Tail>
+        constexpr decltype(auto) Get(Tuple<Head, Tail...>&& tuple) noexcept
+        {
+            return GetHelper<index, Head, Tail...>::value(std::move(tuple));
+        }
+
+        /// Get по типу: тип T должен встречаться в tuple ровно 1 раз
+        template <typename T, typename... Args>
+        constexpr decltype(auto) Get(Tuple<Args...>& tuple) noexcept
+        {
+            static_assert(TypeIndex<T, Args...>::count == 1, "type must occur exactly once");
+            return Get<TypeIndex<T, Args...>::value>(tuple);
+        }
+
+        template <typename T, typename... Args>
+        constexpr decltype(auto) Get(const Tuple<Args...>& tuple) noexcept
+        {
+            static_assert(TypeIndex<T, Args...>::count == 1, "type must occur exactly once");
+            return Get<TypeIndex<T, Args...>::value>(tuple);
+        }
+
+        template <typename T, typename... Args>
+        constexpr decltype(auto) Get(Tuple<Args...>&& tuple) noexcept
+        {
+            static_assert(TypeIndex<T, Args...>::count == 1, "type must occur exactly once");
+            return Get<TypeIndex<T, Args...>::value>(std::move(tuple));
+        }
+
+        /// Structured binding (auto [a, b] = tuple) ищет get (в нижнем регистре) через ADL (argument-dependent lookup)
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) get(Tuple<Args...>& tuple) noexcept { return Get<index>(tuple); }
+
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) get(const Tuple<Args...>& tuple) noexcept { return Get<index>(tuple); }
+
+        template <size_t index, typename... Args>
+        constexpr decltype(auto) get(Tuple<Args...>&& tuple) noexcept { return Get<index>(std::move(tuple)); }
+
         template <typename ...Args>
-        Tuple<Args...> Make_Tuple(Args&& ...args)
+        constexpr Tuple<Args...> Make_Tuple(Args&& ...args)
         {
             return Tuple(std::forward<Args>(args)...);
         }
@@ -234,20 +423,61 @@ namespace tuple
         struct IndexSequence
         {};
 
-        template <size_t... size>
-        struct MakeIndexSequenceImpl;
+        /// Склейка двух последовательностей: <0, 1> + <0, 1, 2> -> <0, 1, 2, 3, 4>
+        template <typename First, typename Second>
+        struct ConcatIndexSequence;
 
-        template <size_t... size>
-        struct MakeIndexSequenceImpl<0, size...>
+        template <size_t... first, size_t... second>
+        struct ConcatIndexSequence<IndexSequence<first...>, IndexSequence<second...>>
+        {
+            using Type = IndexSequence<first..., (sizeof...(first) + second)...>;
+        };
+
+        /*
+         Удвоение: MakeIndexSequenceImpl<N> = MakeIndexSequenceImpl<N/2> + MakeIndexSequenceImpl<N - N/2>.
+         Глубина инстанцирования O(log N) вместо O(N), при этом N/2 и N - N/2 отличаются не более чем на 1, поэтому на каждом уровне инстанцируется не более 2 шаблонов.
+         */
+        template <size_t index>
+        struct MakeIndexSequenceImpl : ConcatIndexSequence<typename MakeIndexSequenceImpl<index / 2>::Type,
+                                                           typename MakeIndexSequenceImpl<index - index / 2>::Type> {};
+
+        template <>
+        struct MakeIndexSequenceImpl<0>
         {
-            using Type = IndexSequence<size...>;
+            using Type = IndexSequence<>;
         };
 
-        template <size_t index, size_t... size>
-        struct MakeIndexSequenceImpl<index, size...> : MakeIndexSequenceImpl<index - 1, index - 1, size...> {};
+        template <>
+        struct MakeIndexSequenceImpl<1>
+        {
+            using Type = IndexSequence<0>;
+        };
 
+        /// Builtin компилятора генерирует последовательность без рекурсии (как std::make_index_sequence): clang и MSVC - __make_integer_seq, GCC - __integer_pack
+        template <typename T, T... index>
+        struct IntegerSequence
+        {
+            using Type = IndexSequence<index...>;
+        };
+
+#if defined(__has_builtin)
+#if __has_builtin(__make_integer_seq)
+        template <size_t index>
+        using MakeIndexSequence = typename __make_integer_seq<IntegerSequence, size_t, index>::Type;
+#elif __has_builtin(__integer_pack)
+        template <size_t index>
+        using MakeIndexSequence = IndexSequence<__integer_pack(index)...>;
+#else
         template <size_t index>
         using MakeIndexSequence = typename MakeIndexSequenceImpl<index>::Type;
+#endif
+#elif defined(_MSC_VER)
+        template <size_t index>
+        using MakeIndexSequence = typename __make_integer_seq<IntegerSequence, size_t, index>::Type;
+#else
+        template <size_t index>
+        using MakeIndexSequence = typename MakeIndexSequenceImpl<index>::Type;
+#endif
 
         template <class P>
         struct TupleTraits
@@ -268,19 +498,117 @@ namespace tuple
         template <typename index, typename... Args>
         struct TupleBaseImpl;
 
-        template <typename... Args>
-        using TupleBase = TupleBaseImpl<MakeIndexSequence<sizeof...(Args)>, Args...>;
+        /// Выравнивание хранимого значения: ссылка хранится как указатель
+        template <typename T>
+        constexpr size_t StorageAlignment = alignof(std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T>*, T>);
 
+        /// Порядок листьев по убыванию выравнивания (alignof), при равном выравнивании сохраняется порядок объявления (устойчивая сортировка вставками)
         template <typename... Args>
-        struct Tuple : TupleBase<Args...>
+        struct AlignmentOrder
         {
-            Tuple() : TupleBase<Args...>() {}
-            explicit Tuple(typename TupleTraits<Args>::ParamType... args):
-            TupleBase<Args...>(args...) {}
+            constexpr static std::array<size_t, sizeof...(Args)> order = []
+            {
+                constexpr size_t alignment[] = {StorageAlignment<Args>..., 0};
+                std::array<size_t, sizeof...(Args)> order{};
+                for (size_t i = 0; i < order.size(); ++i)
+                {
+                    size_t j = i;
+                    for (; j > 0 && alignment[order[j - 1]] < alignment[i]; --j)
+                        order[j] = order[j - 1];
+                    order[j] = i;
+                }
+                return order;
+            }();
+            
+            template <size_t... index>
+            static auto Make(IndexSequence<index...>) -> TupleBaseImpl<IndexSequence<order[index]...>, typename TypeAt<order[index], Args...>::Type...>;
+            
+            using Base = decltype(Make(MakeIndexSequence<sizeof...(Args)>()));
+        };
+
+        /*
+         Политики (policy) расположения листьев TupleLeaf в памяти. Get<index> работает с любой политикой, т.к. лист TupleLeaf<index, T> хранит индекс из порядка объявления.
+         Пример: Tuple<char, double, char, int>
+         DeclarationLayout: char [7 байт padding] double char [3 байта padding] int = 24 байта
+         AlignmentLayout: double int char char [2 байта padding] = 16 байт
+         */
+        struct DeclarationLayout
+        {
+            template <typename... Args>
+            using Base = TupleBaseImpl<MakeIndexSequence<sizeof...(Args)>, Args...>;
+        };
+
+        struct AlignmentLayout
+        {
+            template <typename... Args>
+            using Base = typename AlignmentOrder<Args...>::Base;
+        };
+
+        /// Тег конструктора TupleBaseImpl: аргументы переданы tuple в порядке объявления, а не в порядке листьев
+        struct LayoutTag {};
+
+        /// Тег конструктора TupleBaseImpl: аргументы передаются в листья через идеальную передачу (perfect forwarding)
+        struct ForwardTag {};
+
+        /// Тег кусочного (piecewise) конструирования, как std::piecewise_construct: каждый элемент конструируется на месте из своего tuple аргументов
+        struct Piecewise {};
+
+        template <typename Layout, typename... Args>
+        using TupleBase = typename Layout::template Base<Args...>;
+
+        template <typename Layout, typename... Args>
+        struct BasicTuple : TupleBase<Layout, Args...>
+        {
+            constexpr BasicTuple() : TupleBase<Layout, Args...>() {}
+            constexpr explicit BasicTuple(typename TupleTraits<Args>::ParamType... args) requires std::is_same_v<Layout, DeclarationLayout>:
+            TupleBase<Layout, Args...>(args...) {}
+            constexpr explicit BasicTuple(typename TupleTraits<Args>::ParamType... args) requires (!std::is_same_v<Layout, DeclarationLayout>):
+            TupleBase<Layout, Args...>(LayoutTag(), BasicTuple<DeclarationLayout, typename TupleTraits<Args>::ParamType...>(args...)) {}
+            
+            /// Идеальная передача (perfect forwarding): временные объекты перемещаются в листья, а не копируются; ограничение не дает перехватить копирование tuple из 1 элемента
+            template <typename... UArgs>
+            requires (sizeof...(Args) > 0 && sizeof...(UArgs) == sizeof...(Args) && (std::is_constructible_v<Args, UArgs&&> && ...) &&
+                      !(sizeof...(UArgs) == 1 && (std::is_base_of_v<BasicTuple, std::remove_cvref_t<UArgs>> && ...)))
+            constexpr explicit BasicTuple(UArgs&&... args):
+            BasicTuple(ForwardTag(), std::forward<UArgs>(args)...) {}
+            
+            /// Кусочное конструирование: Tuple<std::string, std::vector<int>>(Piecewise(), Forward_As_Tuple(3, 'a'), Forward_As_Tuple(10, 1))
+            template <typename... Arguments>
+            requires (sizeof...(Arguments) == sizeof...(Args))
+            constexpr BasicTuple(Piecewise, Arguments&&... arguments):
+            TupleBase<Layout, Args...>(Piecewise(), BasicTuple<DeclarationLayout, Arguments&&...>(std::forward<Arguments>(arguments)...)) {}
+            
+            /// Преобразующее копирование и перемещение из tuple с другими типами элементов или другой политикой расположения
+            template <typename ULayout, typename... UArgs>
+            requires (sizeof...(UArgs) == sizeof...(Args) && !std::is_same_v<BasicTuple<ULayout, UArgs...>, BasicTuple> && (std::is_constructible_v<Args, const UArgs&> && ...))
+            constexpr explicit(!(std::is_convertible_v<const UArgs&, Args> && ...)) BasicTuple(const BasicTuple<ULayout, UArgs...>& other):
+            TupleBase<Layout, Args...>(LayoutTag(), other) {}
+            
+            template <typename ULayout, typename... UArgs>
+            requires (sizeof...(UArgs) == sizeof...(Args) && !std::is_same_v<BasicTuple<ULayout, UArgs...>, BasicTuple> && (std::is_constructible_v<Args, UArgs&&> && ...))
+            constexpr explicit(!(std::is_convertible_v<UArgs&&, Args> && ...)) BasicTuple(BasicTuple<ULayout, UArgs...>&& other):
+            TupleBase<Layout, Args...>(LayoutTag(), std::move(other)) {}
             
             constexpr size_t Size() const { return value; }
         public:
             constexpr static size_t value = sizeof...(Args);
+            
+        private:
+            template <typename... UArgs>
+            requires std::is_same_v<Layout, DeclarationLayout>
+            constexpr explicit BasicTuple(ForwardTag, UArgs&&... args):
+            TupleBase<Layout, Args...>(ForwardTag(), std::forward<UArgs>(args)...) {}
+            
+            template <typename... UArgs>
+            requires (!std::is_same_v<Layout, DeclarationLayout>)
+            constexpr explicit BasicTuple(ForwardTag, UArgs&&... args):
+            TupleBase<Layout, Args...>(LayoutTag(), BasicTuple<DeclarationLayout, UArgs&&...>(std::forward<UArgs>(args)...)) {}
+        };
+
+        template <typename... Args>
+        struct Tuple : BasicTuple<DeclarationLayout, Args...>
+        {
+            using BasicTuple<DeclarationLayout, Args...>::BasicTuple;
         };
         
         template <>
@@ -292,13 +620,26 @@ namespace tuple
         // template argument deduction guide
         template<typename ...T> Tuple(T...) -> Tuple<T...>;
 
+        /// Get через ADL: внутри TupleLeaf имя Get скрыто методом TupleLeaf::Get
+        template <size_t index, typename Arguments>
+        constexpr decltype(auto) GetArgument(Arguments&& arguments)
+        {
+            return Get<index>(std::forward<Arguments>(arguments));
+        }
+
         template <size_t index, typename Leaf>
         struct TupleLeaf
         {
-            TupleLeaf() {}
-            explicit TupleLeaf(typename TupleTraits<Leaf>::ParamType leaf) : _leaf(leaf) {}
-            Leaf& Get() { return _leaf; }
-            const Leaf& Get() const { return _leaf; }
+            constexpr TupleLeaf() : _leaf() {}
+            constexpr explicit TupleLeaf(typename TupleTraits<Leaf>::ParamType leaf) : _leaf(leaf) {}
+            template <typename T>
+            requires (!std::is_same_v<std::remove_cvref_t<T>, TupleLeaf>)
+            constexpr explicit TupleLeaf(T&& leaf) : _leaf(std::forward<T>(leaf)) {}
+            /// Элемент конструируется на месте из аргументов tuple arguments
+            template <typename Arguments, size_t... argument>
+            constexpr TupleLeaf(Piecewise, Arguments&& arguments, IndexSequence<argument...>) : _leaf(GetArgument<argument>(std::forward<Arguments>(arguments))...) {}
+            constexpr Leaf& Get() { return _leaf; }
+            constexpr const Leaf& Get() const { return _leaf; }
             
             /// EBO (empty base optimization) - гарантирует размер любого объекта/подъекта должен быть не менее 1 байта, даже если тип является пустым, чтобы можно было получить разные адреса разных объектов одного и того же типа.
             [[no_unique_address]] Leaf _leaf;
@@ -307,35 +648,129 @@ namespace tuple
         template <size_t... index, typename... Args>
         struct TupleBaseImpl<IndexSequence<index...>, Args...> : TupleLeaf<index, Args>...
         {
-            TupleBaseImpl() : TupleLeaf<index, Args>()... {}
-            explicit TupleBaseImpl(typename TupleTraits<Args>::ParamType... args):
+            constexpr TupleBaseImpl() : TupleLeaf<index, Args>()... {}
+            constexpr explicit TupleBaseImpl(typename TupleTraits<Args>::ParamType... args):
             TupleLeaf<index, Args>(args)... {}
+            template <typename... UArgs>
+            constexpr explicit TupleBaseImpl(ForwardTag, UArgs&&... args):
+            TupleLeaf<index, Args>(std::forward<UArgs>(args))... {}
+            /// Листья в порядке политики расположения, аргументы в порядке объявления: лист TupleLeaf<index> берет аргумент Get<index>(arguments)
+            template <typename Arguments>
+            constexpr TupleBaseImpl(LayoutTag, Arguments&& arguments):
+            TupleLeaf<index, Args>(Get<index>(std::forward<Arguments>(arguments)))... {}
+            template <typename Arguments>
+            constexpr TupleBaseImpl(Piecewise, Arguments&& arguments):
+            TupleLeaf<index, Args>(Piecewise(), Get<index>(std::forward<Arguments>(arguments)),
+                                   MakeIndexSequence<std::remove_cvref_t<decltype(Get<index>(arguments))>::value>())... {}
         };
 
         template <size_t index, typename T>
-        T& Get(TupleLeaf<index, T>& leaf)
+        constexpr T& Get(TupleLeaf<index, T>& leaf)
         {
             return leaf.Get();
         }
 
         template <size_t index, typename T>
-        const T& Get(const TupleLeaf<index, T>& leaf)
+        constexpr const T& Get(const TupleLeaf<index, T>& leaf)
         {
             return leaf.Get();
         }
 
+        template <size_t index, typename T>
+        constexpr T&& Get(TupleLeaf<index, T>&& leaf)
+        {
+            return std::forward<T>(leaf.Get());
+        }
+
+        /// Get по типу: index выводится из базового класса TupleLeaf<index, T>, если тип T встречается несколько раз - вывод неоднозначен (ошибка компиляции)
+        template <typename T, size_t index>
+        constexpr T& Get(TupleLeaf<index, T>& leaf)
+        {
+            return leaf.Get();
+        }
+
+        template <typename T, size_t index>
+        constexpr const T& Get(const TupleLeaf<index, T>& leaf)
+        {
+            return leaf.Get();
+        }
+
+        template <typename T, size_t index>
+        constexpr T&& Get(TupleLeaf<index, T>&& leaf)
+        {
+            return std::forward<T>(leaf.Get());
+        }
+
+        /// Structured binding (auto [a, b] = tuple) ищет get (в нижнем регистре) через ADL (argument-dependent lookup)
+        template <size_t index, typename Layout, typename... Args>
+        constexpr decltype(auto) get(BasicTuple<Layout, Args...>& tuple) noexcept { return Get<index>(tuple); }
+
+        template <size_t index, typename Layout, typename... Args>
+        constexpr decltype(auto) get(const BasicTuple<Layout, Args...>& tuple) noexcept { return Get<index>(tuple); }
+
+        template <size_t index, typename Layout, typename... Args>
+        constexpr decltype(auto) get(BasicTuple<Layout, Args...>&& tuple) noexcept { return Get<index>(std::move(tuple)); }
+
+        /// Элементы хранятся по значению (std::decay_t), rvalue перемещаются
         template <typename ...Args>
-        inline Tuple<Args...> Make_Tuple(Args&& ...args)
+        constexpr Tuple<std::decay_t<Args>...> Make_Tuple(Args&& ...args)
         {
-            return Tuple(std::forward<Args>(args)...);
+            return Tuple<std::decay_t<Args>...>(std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        inline Tuple<Args&...> Make_Ref_Tuple(Args&... args)
+        constexpr Tuple<Args&...> Make_Ref_Tuple(Args&... args)
         {
             return Tuple<Args&...>(args...);
         }
+
+        /// Tuple ссылок с сохранением категории значения (lvalue/rvalue), как std::forward_as_tuple - для кусочного конструирования
+        template <typename... Args>
+        constexpr Tuple<Args&&...> Forward_As_Tuple(Args&&... args) noexcept
+        {
+            return Tuple<Args&&...>(std::forward<Args>(args)...);
+        }
     }
 }
 
+/// std::tuple_size и std::tuple_element - для structured binding: auto [a, b, c] = tuple;
+namespace std
+{
+    template <typename... Args>
+    struct tuple_size<::tuple::first_implementation::Tuple<Args...>> : integral_constant<size_t, sizeof...(Args)> {};
+
+    template <size_t index, typename... Args>
+    struct tuple_element<index, ::tuple::first_implementation::Tuple<Args...>>
+    {
+        using type = typename ::tuple::TypeAt<index, Args...>::Type;
+    };
+
+    template <typename... Args>
+    struct tuple_size<::tuple::second_implementation::Tuple<Args...>> : integral_constant<size_t, sizeof...(Args)> {};
+
+    template <size_t index, typename... Args>
+    struct tuple_element<index, ::tuple::second_implementation::Tuple<Args...>>
+    {
+        using type = typename ::tuple::TypeAt<index, Args...>::Type;
+    };
+
+    template <typename... Args>
+    struct tuple_size<::tuple::third_implementation::Tuple<Args...>> : integral_constant<size_t, sizeof...(Args)> {};
+
+    template <size_t index, typename... Args>
+    struct tuple_element<index, ::tuple::third_implementation::Tuple<Args...>>
+    {
+        using type = typename ::tuple::TypeAt<index, Args...>::Type;
+    };
+
+    template <typename Layout, typename... Args>
+    struct tuple_size<::tuple::third_implementation::BasicTuple<Layout, Args...>> : integral_constant<size_t, sizeof...(Args)> {};
+
+    template <size_t index, typename Layout, typename... Args>
+    struct tuple_element<index, ::tuple::third_implementation::BasicTuple<Layout, Args...>>
+    {
+        using type = typename ::tuple::TypeAt<index, Args...>::Type;
+    };
+}
+
 #endif /* Tuple_h */
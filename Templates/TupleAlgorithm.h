@@ -0,0 +1,148 @@
+#ifndef TupleAlgorithm_h
+#define TupleAlgorithm_h
+
+#include "Tuple.h"
+
+#include <array>
+#include <utility>
+
+/*
+ Алгоритмы над Tuple всех трех реализаций: ForEach, Transform, Fold, Zip, TupleCat.
+ Индексы разворачиваются через std::index_sequence в выражение свертки (fold expression), поэтому нет рекурсии ни во время компиляции, ни во время исполнения: после встраивания (inline) получается линейный код - по одному вызову на каждый элемент.
+ Элементы выбираются через Get<index>(tuple), который находится через ADL (argument-dependent lookup) в пространстве имен реализации.
+ */
+
+namespace tuple
+{
+    /// Метафункция: тот же шаблон Tuple (той же реализации и политики расположения), но с другими типами элементов
+    template <typename TTuple, typename... Ts>
+    struct Rebind;
+
+    template <template <typename...> class TTuple, typename... Args, typename... Ts>
+    struct Rebind<TTuple<Args...>, Ts...>
+    {
+        using Type = TTuple<Ts...>;
+    };
+
+    template <typename Layout, typename... Args, typename... Ts>
+    struct Rebind<third_implementation::BasicTuple<Layout, Args...>, Ts...>
+    {
+        using Type = third_implementation::BasicTuple<Layout, Ts...>;
+    };
+
+    template <typename TTuple>
+    constexpr size_t TupleSize = std::tuple_size_v<std::remove_cvref_t<TTuple>>;
+
+    /// Вызов function для каждого элемента по порядку
+    template <typename TTuple, typename TFunction>
+    constexpr void ForEach(TTuple&& tuple, TFunction&& function)
+    {
+        [&]<size_t... index>(std::index_sequence<index...>)
+        {
+            (function(Get<index>(std::forward<TTuple>(tuple))), ...);
+        }(std::make_index_sequence<TupleSize<TTuple>>());
+    }
+
+    /*
+     Новый tuple из результатов function для каждого элемента: Tuple<decltype(function(Get<index>(tuple)))...>.
+     Результаты function передаются напрямую в конструктор итогового tuple (без промежуточных tuple), фигурные скобки гарантируют порядок вызовов слева направо.
+     */
+    template <typename TTuple, typename TFunction>
+    constexpr auto Transform(TTuple&& tuple, TFunction&& function)
+    {
+        return [&]<size_t... index>(std::index_sequence<index...>)
+        {
+            using Result = typename Rebind<std::remove_cvref_t<TTuple>, std::decay_t<decltype(function(Get<index>(std::forward<TTuple>(tuple))))>...>::Type;
+            return Result{function(Get<index>(std::forward<TTuple>(tuple)))...};
+        }(std::make_index_sequence<TupleSize<TTuple>>());
+    }
+
+    /// Левая свертка: function(...function(function(init, Get<0>), Get<1>)..., Get<N-1>), тип результата - тип init
+    template <typename TTuple, typename T, typename TFunction>
+    constexpr T Fold(TTuple&& tuple, T init, TFunction&& function)
+    {
+        [&]<size_t... index>(std::index_sequence<index...>)
+        {
+            ((init = function(std::move(init), Get<index>(std::forward<TTuple>(tuple)))), ...);
+        }(std::make_index_sequence<TupleSize<TTuple>>());
+        return init;
+    }
+
+    /*
+     Zip(Tuple<A0, A1>, Tuple<B0, B1>) -> Tuple<Tuple<A0&, B0&>, Tuple<A1&, B1&>>
+     Внутренние tuple хранят ссылки на элементы (как Make_Ref_Tuple), элементы не копируются. Реализация и политика расположения берутся у первого tuple.
+     */
+    template <typename TTuple, typename... TTuples>
+    constexpr auto Zip(TTuple& tuple, TTuples&... tuples)
+    {
+        static_assert(((TupleSize<TTuple> == TupleSize<TTuples>) && ...), "tuples must have the same size");
+
+        return [&]<size_t... index>(std::index_sequence<index...>)
+        {
+            auto zip = [&]<size_t zip_index>()
+            {
+                using Row = typename Rebind<std::remove_cv_t<TTuple>, decltype(Get<zip_index>(tuple)), decltype(Get<zip_index>(tuples))...>::Type;
+                return Row{Get<zip_index>(tuple), Get<zip_index>(tuples)...};
+            };
+
+            using Result = typename Rebind<std::remove_cv_t<TTuple>, decltype(zip.template operator()<index>())...>::Type;
+            return Result{zip.template operator()<index>()...};
+        }(std::make_index_sequence<TupleSize<TTuple>>());
+    }
+
+    /// Индексы элементов склеиваемых tuple: element j итогового tuple = элемент inner[j] tuple с номером outer[j]
+    template <size_t... sizes>
+    struct CatIndices
+    {
+        constexpr static size_t count = (size_t(0) + ... + sizes);
+
+        struct Indices
+        {
+            std::array<size_t, count> outer{};
+            std::array<size_t, count> inner{};
+        };
+
+        constexpr static Indices indices = []
+        {
+            constexpr size_t size[] = {sizes..., 0};
+            Indices result;
+            size_t element = 0;
+            for (size_t outer = 0; outer < sizeof...(sizes); ++outer)
+            {
+                for (size_t inner = 0; inner < size[outer]; ++inner, ++element)
+                {
+                    result.outer[element] = outer;
+                    result.inner[element] = inner;
+                }
+            }
+            return result;
+        }();
+    };
+
+    /*
+     Склейка tuple за один проход: TupleCat(Tuple<A, B>, Tuple<C>) -> Tuple<A, B, C>.
+     Все элементы передаются сразу в конструктор итогового tuple: из rvalue tuple элементы перемещаются, из lvalue - копируются, промежуточные tuple с элементами не создаются.
+     Индексы outer/inner вычисляются constexpr массивом, поэтому количество инстанцирований линейно от общего числа элементов (без рекурсивной склейки по парам).
+     Реализация и политика расположения берутся у первого tuple.
+     */
+    template <typename TTuple, typename... TTuples>
+    constexpr auto TupleCat(TTuple&& tuple, TTuples&&... tuples)
+    {
+        using Indices = CatIndices<TupleSize<TTuple>, TupleSize<TTuples>...>;
+        constexpr auto indices = Indices::indices;
+        auto arguments = third_implementation::Forward_As_Tuple(std::forward<TTuple>(tuple), std::forward<TTuples>(tuples)...);
+
+        return [&]<size_t... element>(std::index_sequence<element...>)
+        {
+            using Result = typename Rebind<std::remove_cvref_t<TTuple>,
+                                           std::tuple_element_t<indices.inner[element],
+                                                                std::remove_cvref_t<typename TypeAt<indices.outer[element], TTuple, TTuples...>::Type>>...>::Type;
+            if constexpr (sizeof...(element) == 0)
+                return Result();
+            else
+                return Result(Get<indices.inner[element]>(Get<indices.outer[element]>(std::move(arguments)))...);
+        }(std::make_index_sequence<Indices::count>());
+    }
+}
+
+#endif /* TupleAlgorithm_h */
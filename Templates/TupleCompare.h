@@ -0,0 +1,183 @@
+#ifndef TupleCompare_h
+#define TupleCompare_h
+
+#include "TupleAlgorithm.h"
+
+#include <compare>
+#include <concepts>
+#include <cstring>
+#include <functional>
+
+/*
+ Сравнение (==, !=, <, <=, >, >=, <=>) и хеширование Tuple всех трех реализаций - для ключей std::unordered_map и std::map.
+ Сравнение лексикографическое: элементы сравниваются по порядку до первого различия. Сравнивать можно tuple с разными, но сравнимыми типами элементов: Tuple<std::string, int> == Tuple<std::string_view, long>.
+ Быстрый путь: если все элементы - целые числа и в объекте нет padding (std::has_unique_object_representations), то tuple равны тогда и только тогда, когда равны их байты - == выполняется через memcmp.
+ Hash - прозрачный (is_transparent): вместе с std::equal_to<> позволяет искать в std::unordered_map<Tuple<std::string, int>, ...> по Tuple<std::string_view, int> без создания std::string (heterogeneous lookup).
+ */
+
+namespace tuple
+{
+    /// Сравнение пары элементов как в std::tuple (synth-three-way): <=>, а для типов только с < - std::weak_ordering по двум вызовам <
+    struct SynthThreeWay
+    {
+        template <typename TLeft, typename TRight>
+        requires std::three_way_comparable_with<TLeft, TRight> || requires(const TLeft& left, const TRight& right)
+        {
+            { left < right } -> std::convertible_to<bool>;
+            { right < left } -> std::convertible_to<bool>;
+        }
+        constexpr auto operator()(const TLeft& left, const TRight& right) const
+        {
+            if constexpr (std::three_way_comparable_with<TLeft, TRight>)
+            {
+                return left <=> right;
+            }
+            else
+            {
+                if (left < right)
+                    return std::weak_ordering::less;
+                if (right < left)
+                    return std::weak_ordering::greater;
+                return std::weak_ordering::equivalent;
+            }
+        }
+    };
+
+    /// Тип результата <=>: общая категория сравнения (strong/weak/partial_ordering) всех пар элементов
+    template <typename TLeft, typename TRight, typename Indices = std::make_index_sequence<TupleSize<TLeft>>>
+    struct CompareResult;
+
+    template <typename TLeft, typename TRight, size_t... index>
+    struct CompareResult<TLeft, TRight, std::index_sequence<index...>>
+    {
+        using Type = std::common_comparison_category_t<decltype(SynthThreeWay()(std::declval<const std::tuple_element_t<index, TLeft>&>(),
+                                                                                std::declval<const std::tuple_element_t<index, TRight>&>()))...>;
+    };
+
+    /// Быстрый путь memcmp: одинаковые типы, только целые элементы, нет padding
+    template <typename TLeft, typename TRight, typename Indices = std::make_index_sequence<TupleSize<TLeft>>>
+    constexpr bool IsBytewiseComparable = false;
+
+    template <typename TLeft, typename TRight, size_t... index>
+    constexpr bool IsBytewiseComparable<TLeft, TRight, std::index_sequence<index...>> =
+        std::is_same_v<TLeft, TRight> && (std::is_integral_v<std::tuple_element_t<index, TLeft>> && ...) && std::has_unique_object_representations_v<TLeft>;
+
+    template <typename TLeft, typename TRight>
+    constexpr bool Equal(const TLeft& left, const TRight& right)
+    {
+        static_assert(TupleSize<TLeft> == TupleSize<TRight>, "tuples must have the same size");
+
+        if constexpr (IsBytewiseComparable<TLeft, TRight>)
+        {
+            if (!std::is_constant_evaluated())
+                return std::memcmp(&left, &right, sizeof(TLeft)) == 0;
+        }
+
+        return [&]<size_t... index>(std::index_sequence<index...>)
+        {
+            return ((Get<index>(left) == Get<index>(right)) && ...);
+        }(std::make_index_sequence<TupleSize<TLeft>>());
+    }
+
+    template <typename TLeft, typename TRight>
+    constexpr auto Compare(const TLeft& left, const TRight& right)
+    {
+        static_assert(TupleSize<TLeft> == TupleSize<TRight>, "tuples must have the same size");
+
+        typename CompareResult<TLeft, TRight>::Type result = std::strong_ordering::equal;
+        [&]<size_t... index>(std::index_sequence<index...>)
+        {
+            /// Свертка по || останавливается на первой паре неравных элементов
+            (((result = SynthThreeWay()(Get<index>(left), Get<index>(right))) != 0) || ...);
+        }(std::make_index_sequence<TupleSize<TLeft>>());
+        return result;
+    }
+
+    /*
+     Hash - комбинация хешей элементов. Целые элементы берутся как машинное слово без вызова std::hash, остальные - через std::hash<T>.
+     Хеш зависит только от значений элементов, поэтому равные tuple разных типов (Tuple<std::string, int> и Tuple<std::string_view, long>) имеют одинаковый хеш.
+     */
+    struct Hash
+    {
+        using is_transparent = void;
+
+        template <typename TTuple>
+        size_t operator()(const TTuple& tuple) const noexcept
+        {
+            return Fold(tuple, size_t(0), [](size_t seed, const auto& value)
+            {
+                return Combine(seed, HashValue(value));
+            });
+        }
+
+    private:
+        template <typename T>
+        static size_t HashValue(const T& value) noexcept
+        {
+            if constexpr (std::is_integral_v<T>)
+                return static_cast<size_t>(value);
+            else
+                return std::hash<T>()(value);
+        }
+
+        static constexpr size_t Combine(size_t seed, size_t hash) noexcept
+        {
+            return (seed ^ hash) * 0x9E3779B97F4A7C15ull + (seed >> 29);
+        }
+    };
+
+    /// Операторы объявлены в пространстве имен каждой реализации, чтобы находиться через ADL. != , <, <=, >, >= компилятор выводит из == и <=> (C++20)
+    namespace first_implementation
+    {
+        template <typename... TLeft, typename... TRight>
+        requires (sizeof...(TLeft) == sizeof...(TRight))
+        constexpr bool operator==(const Tuple<TLeft...>& left, const Tuple<TRight...>& right)
+        {
+            return Equal(left, right);
+        }
+
+        template <typename... TLeft, typename... TRight>
+        requires (sizeof...(TLeft) == sizeof...(TRight))
+        constexpr auto operator<=>(const Tuple<TLeft...>& left, const Tuple<TRight...>& right)
+        {
+            return Compare(left, right);
+        }
+    }
+
+    namespace second_implementation
+    {
+        template <typename... TLeft, typename... TRight>
+        requires (sizeof...(TLeft) == sizeof...(TRight))
+        constexpr bool operator==(const Tuple<TLeft...>& left, const Tuple<TRight...>& right)
+        {
+            return Equal(left, right);
+        }
+
+        template <typename... TLeft, typename... TRight>
+        requires (sizeof...(TLeft) == sizeof...(TRight))
+        constexpr auto operator<=>(const Tuple<TLeft...>& left, const Tuple<TRight...>& right)
+        {
+            return Compare(left, right);
+        }
+    }
+
+    namespace third_implementation
+    {
+        /// Tuple<Args...> наследуется от BasicTuple, поэтому операторы подходят для любой политики расположения
+        template <typename LeftLayout, typename... TLeft, typename RightLayout, typename... TRight>
+        requires (sizeof...(TLeft) == sizeof...(TRight))
+        constexpr bool operator==(const BasicTuple<LeftLayout, TLeft...>& left, const BasicTuple<RightLayout, TRight...>& right)
+        {
+            return Equal(left, right);
+        }
+
+        template <typename LeftLayout, typename... TLeft, typename RightLayout, typename... TRight>
+        requires (sizeof...(TLeft) == sizeof...(TRight))
+        constexpr auto operator<=>(const BasicTuple<LeftLayout, TLeft...>& left, const BasicTuple<RightLayout, TRight...>& right)
+        {
+            return Compare(left, right);
+        }
+    }
+}
+
+#endif /* TupleCompare_h */
@@ -0,0 +1,399 @@
+#ifndef TupleSerialization_h
+#define TupleSerialization_h
+
+#include "TupleAlgorithm.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ Двоичная запись Tuple в файл и чтение через отображение файла в память (memory-mapped file) без копирования.
+ Формат записи: элементы по порядку объявления, каждый выровнен по своему alignof относительно начала файла:
+ - тривиально копируемый элемент (int, double, POD структура) - сырые байты sizeof(T)
+ - std::string - длина uint64_t (выровнена по 8) + байты строки без '\0'
+ Конец записи дополняется до выравнивания записи, поэтому каждая следующая запись тоже выровнена.
+ Отображение файла начинается с границы страницы, поэтому элементы можно читать по ссылке прямо из отображения: запись - Tuple<const T&..., std::string_view>.
+ Если все элементы тривиально копируемые, размер записи постоянный - доступен произвольный доступ reader[i], иначе - только последовательный проход.
+ Файл пишется потоком через буфер фиксированного размера (режим Append дописывает в конец существующего файла), а отображение подгружает страницы по мере обращения - файлы могут быть больше оперативной памяти.
+ Формат платформо-зависимый (порядок байтов, sizeof): файл читается на той же архитектуре.
+ Чтение проверяет каждое смещение и длину строки по размеру отображения: обрезанный или поврежденный файл - исключение std::runtime_error, а не чтение за пределами отображения.
+ */
+
+namespace tuple
+{
+    namespace serialization
+    {
+        template <typename T>
+        constexpr bool IsString = std::is_same_v<T, std::string>;
+
+        template <typename T>
+        constexpr bool IsSerializable = IsString<T> || (std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_reference_v<T>);
+
+        /// Тип элемента при чтении: ссылка в отображение файла или std::string_view для строк
+        template <typename T>
+        using ViewType = std::conditional_t<IsString<T>, std::string_view, const T&>;
+
+        /// Выравнивание элемента в файле: для строки - выравнивание длины uint64_t
+        template <typename T>
+        constexpr size_t Alignment = IsString<T> ? alignof(uint64_t) : alignof(T);
+
+        constexpr size_t Align(size_t offset, size_t alignment)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        template <typename... Ts>
+        struct RecordLayout
+        {
+            static_assert(sizeof...(Ts) > 0, "at least one element");
+            static_assert((IsSerializable<Ts> && ...), "elements must be trivially copyable or std::string");
+
+            constexpr static size_t alignment = std::max({Alignment<Ts>...});
+            constexpr static bool fixed = !(IsString<Ts> || ...);
+
+            /// Смещения элементов от начала записи и размер записи - только для записей постоянного размера
+            constexpr static std::array<size_t, sizeof...(Ts)> offsets = []
+            {
+                std::array<size_t, sizeof...(Ts)> result{};
+                if constexpr (fixed)
+                {
+                    size_t offset = 0, index = 0;
+                    ((offset = Align(offset, alignof(Ts)), result[index++] = offset, offset += sizeof(Ts)), ...);
+                }
+                return result;
+            }();
+
+            constexpr static size_t size = fixed ? Align(offsets.back() + sizeof(typename TypeAt<sizeof...(Ts) - 1, Ts...>::Type), alignment) : 0;
+            /// Размер файла из целых записей кратен boundary: проверяется и при чтении, и при дозаписи
+            constexpr static size_t boundary = fixed ? size : alignment;
+        };
+
+        /// Файл, отображенный в память только для чтения (RAII)
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::string& path)
+            {
+#if defined(_WIN32)
+                _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (_file == INVALID_HANDLE_VALUE)
+                    throw std::system_error(int(GetLastError()), std::system_category(), "CreateFile " + path);
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(_file, &size))
+                    Fail("GetFileSizeEx " + path);
+                _size = size_t(size.QuadPart);
+                if (_size > 0)
+                {
+                    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (!_mapping)
+                        Fail("CreateFileMapping " + path);
+                    _data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+                    if (!_data)
+                        Fail("MapViewOfFile " + path);
+                }
+#else
+                const int file = ::open(path.c_str(), O_RDONLY);
+                if (file < 0)
+                    throw std::system_error(errno, std::generic_category(), "open " + path);
+                struct stat status;
+                if (::fstat(file, &status) != 0)
+                {
+                    const int error = errno;
+                    ::close(file);
+                    throw std::system_error(error, std::generic_category(), "fstat " + path);
+                }
+                _size = size_t(status.st_size);
+                if (_size > 0)
+                {
+                    void* data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+                    if (data == MAP_FAILED)
+                    {
+                        const int error = errno;
+                        ::close(file);
+                        throw std::system_error(error, std::generic_category(), "mmap " + path);
+                    }
+                    ::madvise(data, _size, MADV_SEQUENTIAL);
+                    _data = static_cast<const char*>(data);
+                }
+                ::close(file); // отображение остается действительным после закрытия дескриптора
+#endif
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile()
+            {
+#if defined(_WIN32)
+                if (_data)
+                    UnmapViewOfFile(_data);
+                if (_mapping)
+                    CloseHandle(_mapping);
+                CloseHandle(_file);
+#else
+                if (_data)
+                    ::munmap(const_cast<char*>(_data), _size);
+#endif
+            }
+
+            const char* data() const noexcept { return _data; }
+            size_t size() const noexcept { return _size; }
+
+        private:
+#if defined(_WIN32)
+            /// Ошибка в конструкторе: деструктор не вызывается, открытые дескрипторы закрываются здесь
+            [[noreturn]] void Fail(const std::string& what)
+            {
+                const auto error = int(GetLastError());
+                if (_mapping)
+                    CloseHandle(_mapping);
+                CloseHandle(_file);
+                throw std::system_error(error, std::system_category(), what);
+            }
+#endif
+
+        private:
+            const char* _data = nullptr;
+            size_t _size = 0;
+#if defined(_WIN32)
+            HANDLE _file = INVALID_HANDLE_VALUE;
+            HANDLE _mapping = nullptr;
+#endif
+        };
+
+        enum class Mode
+        {
+            Truncate, // Новый файл
+            Append    // Дописывать в конец существующего файла
+        };
+
+        struct FileCloser
+        {
+            void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+        };
+
+        /// Потоковая запись записей Tuple<Ts...>: байты копируются в буфер, буфер сбрасывается в файл целиком при заполнении
+        template <typename... Ts>
+        class RecordWriter
+        {
+            using Layout = RecordLayout<Ts...>;
+
+        public:
+            explicit RecordWriter(const std::string& path, Mode mode = Mode::Truncate, size_t capacity = 1 << 16):
+            _file(std::fopen(path.c_str(), mode == Mode::Append ? "ab" : "wb")),
+            _capacity(capacity)
+            {
+                if (!_file)
+                    throw std::system_error(errno, std::generic_category(), "fopen " + path);
+                std::fseek(_file.get(), 0, SEEK_END);
+#if defined(_WIN32)
+                _offset = size_t(_ftelli64(_file.get())); // ftell возвращает long - 32 бита на Windows
+#else
+                _offset = size_t(ftello(_file.get()));
+#endif
+                if (_offset % Layout::boundary != 0)
+                    throw std::runtime_error("file " + path + " does not end on a record boundary");
+                _buffer.reserve(capacity);
+            }
+
+            RecordWriter(const RecordWriter&) = delete;
+            RecordWriter& operator=(const RecordWriter&) = delete;
+
+            /// Деструктор не бросает исключений: ошибку записи последнего буфера можно узнать только явным вызовом Flush
+            ~RecordWriter()
+            {
+                std::fwrite(_buffer.data(), 1, _buffer.size(), _file.get());
+            }
+
+            /// Запись любого tuple из sizeof...(Ts) элементов: элементы приводятся к Ts, для строк достаточно приведения к std::string_view
+            template <typename TTuple>
+            void Write(const TTuple& record)
+            {
+                static_assert(TupleSize<TTuple> == sizeof...(Ts), "record must have one element per field");
+                [&]<size_t... index>(std::index_sequence<index...>)
+                {
+                    (WriteElement<typename TypeAt<index, Ts...>::Type>(Get<index>(record)), ...);
+                }(std::make_index_sequence<sizeof...(Ts)>());
+                Pad(Layout::alignment);
+                if (_buffer.size() >= _capacity)
+                    Flush();
+            }
+
+            void Flush()
+            {
+                if (!_buffer.empty() && std::fwrite(_buffer.data(), 1, _buffer.size(), _file.get()) != _buffer.size())
+                    throw std::system_error(errno, std::generic_category(), "fwrite");
+                _buffer.clear();
+                std::fflush(_file.get());
+            }
+
+        private:
+            template <typename T, typename U>
+            void WriteElement(const U& value)
+            {
+                if constexpr (IsString<T>)
+                {
+                    const std::string_view string(value);
+                    const uint64_t length = string.size();
+                    Pad(alignof(uint64_t));
+                    Append(&length, sizeof(length));
+                    Append(string.data(), string.size());
+                }
+                else
+                {
+                    const T element(value);
+                    Pad(alignof(T));
+                    Append(&element, sizeof(T));
+                }
+            }
+
+            void Append(const void* data, size_t size)
+            {
+                const char* bytes = static_cast<const char*>(data);
+                _buffer.insert(_buffer.end(), bytes, bytes + size);
+                _offset += size;
+            }
+
+            /// Нулевые байты padding, смещение считается от начала файла
+            void Pad(size_t alignment)
+            {
+                const size_t padding = Align(_offset, alignment) - _offset;
+                _buffer.insert(_buffer.end(), padding, '\0');
+                _offset += padding;
+            }
+
+        private:
+            std::unique_ptr<std::FILE, FileCloser> _file; // Закрывается и при исключении из конструктора
+            size_t _capacity;
+            size_t _offset = 0;
+            std::vector<char> _buffer;
+        };
+
+        /// Чтение записей Tuple<Ts...> из отображения файла: записи - Tuple ссылок в отображение, данные не копируются
+        template <typename... Ts>
+        class RecordReader
+        {
+            using Layout = RecordLayout<Ts...>;
+
+        public:
+            using View = third_implementation::Tuple<ViewType<Ts>...>;
+
+            class Iterator
+            {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = View;
+                using difference_type = std::ptrdiff_t;
+
+                Iterator(const char* data, size_t size, size_t offset) : _data(data), _size(size), _offset(offset) {}
+
+                View operator*() const { return Parse(_data, _size, _offset).first; }
+                Iterator& operator++()
+                {
+                    _offset = Layout::fixed ? _offset + Layout::size : Parse(_data, _size, _offset).second;
+                    return *this;
+                }
+                bool operator==(const Iterator& other) const noexcept { return _offset == other._offset; }
+
+            private:
+                const char* _data;
+                size_t _size;
+                size_t _offset;
+            };
+
+            /// Размер файла кратен размеру записи (для постоянного размера) - проход по записям заканчивается ровно на end()
+            explicit RecordReader(const std::string& path) : _file(path)
+            {
+                if (_file.size() % Layout::boundary != 0)
+                    throw std::runtime_error("file " + path + " does not end on a record boundary");
+            }
+
+            Iterator begin() const noexcept { return Iterator(_file.data(), _file.size(), 0); }
+            Iterator end() const noexcept { return Iterator(_file.data(), _file.size(), _file.size()); }
+
+            /// Произвольный доступ - только для записей постоянного размера
+            size_t size() const noexcept requires Layout::fixed { return _file.size() / Layout::size; }
+
+            View operator[](size_t index) const requires Layout::fixed
+            {
+                return Parse(_file.data(), _file.size(), index * Layout::size).first;
+            }
+
+        private:
+            /// Запись по смещению offset и смещение следующей записи; запись за пределами size - исключение
+            static std::pair<View, size_t> Parse(const char* data, size_t size, size_t offset)
+            {
+                return [&]<size_t... index>(std::index_sequence<index...>)
+                {
+                    if constexpr (Layout::fixed)
+                    {
+                        if (offset > size || size - offset < Layout::size)
+                            throw std::runtime_error("record at offset " + std::to_string(offset) + " is out of file bounds");
+                        return std::pair<View, size_t>(View(*reinterpret_cast<const Ts*>(data + offset + Layout::offsets[index])...), offset + Layout::size);
+                    }
+                    else
+                    {
+                        /// Фигурные скобки гарантируют разбор элементов слева направо
+                        View view{ParseElement<Ts>(data, size, offset)...};
+                        return std::pair<View, size_t>(view, Align(offset, Layout::alignment));
+                    }
+                }(std::make_index_sequence<sizeof...(Ts)>());
+            }
+
+            template <typename T>
+            static ViewType<T> ParseElement(const char* data, size_t size, size_t& offset)
+            {
+                if constexpr (IsString<T>)
+                {
+                    offset = Align(offset, alignof(uint64_t));
+                    Check(size, offset, sizeof(uint64_t));
+                    const uint64_t length = *reinterpret_cast<const uint64_t*>(data + offset);
+                    offset += sizeof(uint64_t);
+                    Check(size, offset, length);
+                    offset += size_t(length);
+                    return std::string_view(data + offset - length, size_t(length));
+                }
+                else
+                {
+                    offset = Align(offset, alignof(T));
+                    Check(size, offset, sizeof(T));
+                    offset += sizeof(T);
+                    return *reinterpret_cast<const T*>(data + offset - sizeof(T));
+                }
+            }
+
+            /// length байт по смещению offset помещаются в файл (без переполнения при поврежденной длине)
+            static void Check(size_t size, size_t offset, uint64_t length)
+            {
+                if (offset > size || length > size - offset)
+                    throw std::runtime_error("corrupt record: " + std::to_string(length) + " bytes at offset " + std::to_string(offset) + " exceed file size " + std::to_string(size));
+            }
+
+        private:
+            MappedFile _file;
+        };
+    }
+}
+
+#endif /* TupleSerialization_h */
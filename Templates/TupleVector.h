@@ -0,0 +1,139 @@
+#ifndef TupleVector_h
+#define TupleVector_h
+
+#include "Tuple.h"
+
+#include <span>
+#include <vector>
+
+/*
+ TupleVector - контейнер записей Tuple<Ts...>, хранящий каждый тип в отдельном непрерывном столбце (struct of arrays, SoA) вместо массива записей (array of structs, AoS).
+ Плюсы:
+ - при проходе по одному полю в кэш процессора загружается только этот столбец, а не вся запись
+ - нет padding между полями разных типов
+ - столбец можно векторизовать (SIMD)
+ Минусы:
+ - запись целиком разбросана по нескольким массивам: доступ к строке - это Tuple ссылок (как Make_Ref_Tuple)
+ - push_back выполняет по одному push_back на каждый столбец
+ */
+
+namespace tuple
+{
+    namespace third_implementation
+    {
+        template <typename... Ts>
+        class TupleVector
+        {
+            static_assert(!(std::is_same_v<Ts, bool> || ...), "std::vector<bool> is not contiguous, use char or uint8_t");
+            static_assert(!(std::is_reference_v<Ts> || ...), "columns must store values");
+            static_assert(sizeof...(Ts) > 0, "at least one column");
+
+        public:
+            using Row = Tuple<Ts&...>;
+            using ConstRow = Tuple<const Ts&...>;
+
+            TupleVector() = default;
+
+            void reserve(size_t capacity)
+            {
+                ForEachColumn([capacity](auto& column) { column.reserve(capacity); });
+            }
+
+            void push_back(const Ts&... values)
+            {
+                PushBack(MakeIndexSequence<sizeof...(Ts)>(), values...);
+            }
+
+            void push_back(const Tuple<Ts...>& row)
+            {
+                [&]<size_t... index>(IndexSequence<index...>)
+                {
+                    PushBack(IndexSequence<index...>(), Get<index>(row)...);
+                }(MakeIndexSequence<sizeof...(Ts)>());
+            }
+
+            /// Каждый аргумент конструирует элемент своего столбца на месте
+            template <typename... Args>
+            Row emplace_back(Args&&... args)
+            {
+                static_assert(sizeof...(Args) == sizeof...(Ts), "one argument per column");
+                PushBack(MakeIndexSequence<sizeof...(Ts)>(), std::forward<Args>(args)...);
+                return (*this)[size() - 1];
+            }
+
+            void pop_back()
+            {
+                ForEachColumn([](auto& column) { column.pop_back(); });
+            }
+
+            void clear() noexcept
+            {
+                ForEachColumn([](auto& column) { column.clear(); });
+            }
+
+            size_t size() const noexcept { return Get<0>(_columns).size(); }
+            bool empty() const noexcept { return Get<0>(_columns).empty(); }
+
+            /// Столбец index - непрерывный массив, span действителен до изменения размера контейнера
+            template <size_t index>
+            auto Column() noexcept
+            {
+                return std::span(Get<index>(_columns));
+            }
+
+            template <size_t index>
+            auto Column() const noexcept
+            {
+                return std::span(Get<index>(_columns));
+            }
+
+            /// Строка - Tuple ссылок на элементы столбцов
+            Row operator[](size_t row)
+            {
+                return RowAt<Row>(MakeIndexSequence<sizeof...(Ts)>(), _columns, row);
+            }
+
+            ConstRow operator[](size_t row) const
+            {
+                return RowAt<ConstRow>(MakeIndexSequence<sizeof...(Ts)>(), _columns, row);
+            }
+
+        private:
+            /// Исключение в столбце k: из столбцов 0..k-1 удаляются добавленные элементы, все столбцы снова одного размера
+            template <size_t... index, typename... Args>
+            void PushBack(IndexSequence<index...>, Args&&... args)
+            {
+                size_t pushed = 0;
+                try
+                {
+                    ((Get<index>(_columns).emplace_back(std::forward<Args>(args)), ++pushed), ...);
+                }
+                catch (...)
+                {
+                    ((index < pushed ? Get<index>(_columns).pop_back() : void()), ...);
+                    throw;
+                }
+            }
+
+            template <typename TRow, size_t... index, typename TColumns>
+            static TRow RowAt(IndexSequence<index...>, TColumns& columns, size_t row)
+            {
+                return TRow(Get<index>(columns)[row]...);
+            }
+
+            template <typename TFunction>
+            void ForEachColumn(TFunction&& function)
+            {
+                [&]<size_t... index>(IndexSequence<index...>)
+                {
+                    (function(Get<index>(_columns)), ...);
+                }(MakeIndexSequence<sizeof...(Ts)>());
+            }
+
+        private:
+            Tuple<std::vector<Ts>...> _columns;
+        };
+    }
+}
+
+#endif /* TupleVector_h */
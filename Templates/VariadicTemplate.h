@@ -1,6 +1,10 @@
 #ifndef Arguments_h
 #define Arguments_h
 
+#include "ShardedCounter.h"
+
+#include <typeinfo>
+
 /*
  Сайты: https://infotraining.bitbucket.io/cpp-adv/variadic-templates.html
         https://www.fluentcpp.com/2018/06/22/variadic-crtp-opt-in-for-class-features-at-compile-time/
@@ -89,15 +93,25 @@ namespace variadic_template
         // explicit deduction guide (not needed as of C++20)
         template <typename ...Mixins> Mixin(Mixins...) -> Mixin<Mixins...>;
 
+        /// Количество живых объектов T без гонки данных: счетчик разбит на части по потокам, тип T регистрируется в telemetry::CounterRegistry
         template <typename T>
         class Counter
         {
         public:
-            Counter() { ++_counter; }
-            ~Counter() { --_counter; }
-            static size_t count() noexcept { return _counter; }
+            Counter() noexcept { Increment(); }
+            Counter(const Counter&) noexcept { Increment(); } // Копия - тоже живой объект, который уменьшит счетчик в деструкторе
+            Counter& operator=(const Counter&) = default;
+            ~Counter() { _counter.Decrement(); }
+            static size_t count() noexcept { return _counter.Count(); }
+        private:
+            static void Increment() noexcept
+            {
+                (void)_registered; // Обращение инстанцирует _registered: регистрация при инициализации программы
+                _counter.Increment();
+            }
         private:
-            inline static size_t _counter;
+            inline static constinit telemetry::ShardedCounter _counter; // Константная инициализация: объекты, созданные до динамической инициализации, не теряются
+            inline static const bool _registered = telemetry::CounterRegistry::Instance().Add(telemetry::TypeName(typeid(T)), _counter);
         };
 
         template <typename T>
@@ -1,27 +1,81 @@
 #include <iostream>
 
 #include "Auto.h"
+#include "Benchmark.h"
 #include "Callback.h"
+#include "CallbackQueue.h"
 #include "Forward.h"
 #include "Instantiation.h"
 #include "invoke_apply.h"
 #include "Concept.h"
 #include "CRTP.h"
+#include "Coroutine.h"
+#include "Dispatch.h"
+#include "ExpressionTemplate.h"
 #include "FoldExpression.h"
 #include "Function.h"
 #include "Non-type.h"
+#include "MpscQueue.h"
+#include "PackedTuple.h"
+#include "Record.h"
 #include "Matching.h"
 #include "Metafunction.h"
 #include "SFINAE.h"
+#include "SharedTuple.h"
+#include "Signal.h"
 #include "Specialization.h"
+#include "ThreadPool.h"
+#include "TimerWheel.h"
 #include "typedef_using.h"
 #include "Tuple.h"
+#include "TupleAlgorithm.h"
+#include "TupleCompare.h"
+#include "TupleSerialization.h"
+#include "TupleVector.h"
 #include "VariadicTemplate.h"
 
+#include <any>
 #include <array>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 
+/// Глобальный operator new считает выделения памяти для benchmark
+void* operator new(std::size_t size)
+{
+    ++benchmark::allocations;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 /*
  Сайты: http://scrutator.me/post/2017/08/11/cpp17_lang_features_p1.aspx
         http://scrutator.me/post/2017/04/10/has_function_metaprogramming.aspx
@@ -501,10 +555,576 @@ int main()
         using namespace callback;
         std::cout << "callback" << std::endl;
         
-        Example example;
+        Example example, subscriber;
         Permission(example, &Example::Method).Run();
         Permission(example, &Example::Method1).Run();
         Permission(example, &Example::Method2).Run();
+        
+        /// Benchmark: std::function + std::bind внутри Callback и unique_ptr<ICallback> (2 allocations) против InplaceCallback (0 allocations)
+        struct Accumulator
+        {
+            void Add(int value) { sum += value; }
+            void Refresh(int value) // Дорогой вызов: важен только последний
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    sum += value;
+                    benchmark::DoNotOptimize(sum);
+                }
+            }
+            long sum = 0;
+        };
+        Accumulator accumulator;
+        benchmark::Measure("unique_ptr<Callback>: construct", 1'000'000, [&]()
+        {
+            std::unique_ptr<ICallback> callback(new Callback(accumulator, &Accumulator::Add, 1));
+            benchmark::DoNotOptimize(callback);
+        });
+        benchmark::Measure("InplaceCallback: construct", 1'000'000, [&]()
+        {
+            InplaceCallback<void()> callback(accumulator, &Accumulator::Add, 1);
+            benchmark::DoNotOptimize(callback);
+        });
+        std::unique_ptr<ICallback> callback(new Callback(accumulator, &Accumulator::Add, 1));
+        InplaceCallback<void()> inplace_callback(accumulator, &Accumulator::Add, 1);
+        benchmark::Measure("unique_ptr<Callback>: invoke", 10'000'000, [&]() { (*callback)(); });
+        benchmark::Measure("InplaceCallback: invoke", 10'000'000, [&]() { inplace_callback(); });
+        
+        /// Delegate - 2 машинных слова (указатель на объект + функция-переходник), объект не копируется
+        auto delegate = MakeDelegate<&Example::Method1>(example); // Delegate<void(bool)>
+        delegate(false);
+        std::vector<Delegate<void(bool, bool)>> subscribers{MakeDelegate<&Example::Method2>(example), Delegate<void(bool, bool)>::Bind<&Example::Method2>(subscriber)};
+        std::erase(subscribers, MakeDelegate<&Example::Method2>(example)); // Отписка: сравнение объекта и метода
+        static_assert(sizeof(Delegate<void(bool)>) == 2 * sizeof(void*) && std::is_trivially_copyable_v<Delegate<void(bool)>>);
+        auto accumulator_delegate = MakeDelegate<&Accumulator::Add>(accumulator);
+        benchmark::Measure("Delegate: invoke", 10'000'000, [&]() { accumulator_delegate(1); });
+        
+        /// CoalescingQueue: повторная постановка того же метода того же объекта заменяет ожидающий вызов
+        CoalescingQueue queue;
+        for (int i = 0; i < 100; ++i)
+            queue.Post<&Example::Method1>(example, i % 2 == 0);
+        queue.Drain(); // 1 вызов Method1 с последним аргументом (false)
+        
+        /// Разные методы одного объекта - разные ключи: выполняются оба вызова
+        {
+            Accumulator accumulator;
+            queue.Post<&Accumulator::Add>(accumulator, 1);
+            queue.Post<&Accumulator::Refresh>(accumulator, 1);
+            [[maybe_unused]] const size_t executed = queue.Drain();
+            assert(executed == 2 && accumulator.sum == 101);
+        }
+        
+        /// Benchmark: пачка из 100 Post дорогого вызова для 10 объектов и Drain - очередь без схлопывания против CoalescingQueue
+        std::array<Accumulator, 10> accumulators;
+        std::vector<InplaceCallback<void()>> plain_queue;
+        benchmark::Measure("plain queue: 100 Post + Drain", 10'000, [&]()
+        {
+            for (int i = 0; i < 100; ++i)
+                plain_queue.emplace_back(&accumulators[i % accumulators.size()], &Accumulator::Refresh, i);
+            for (auto& task : plain_queue)
+                task();
+            plain_queue.clear();
+        });
+        benchmark::Measure("CoalescingQueue: 100 Post + Drain", 10'000, [&]()
+        {
+            for (int i = 0; i < 100; ++i)
+                queue.Post<&Accumulator::Refresh>(accumulators[i % accumulators.size()], i);
+            queue.Drain();
+        });
+        const auto stats = queue.GetStats();
+        std::cout << "CoalescingQueue: posted " << stats.posted << ", coalesced " << stats.coalesced << ", executed " << stats.executed << std::endl;
+    }
+    // thread pool
+    {
+        using namespace callback;
+        std::cout << "thread pool" << std::endl;
+        
+        ThreadPool pool(4);
+        Example example;
+        auto answer = pool.Submit([]() { return 42; }); // TaskHandle<int>
+        pool.Post(InplaceCallback<void()>(example, &Example::Method1, true));
+        [[maybe_unused]] int result = answer.Get();
+        std::vector<double> values(1000, 1.0);
+        pool.ParallelFor(0, values.size(), [&](size_t index) { values[index] *= 2.0; }, 100);
+        
+        /// Один поток занят долгой задачей, остальные спят: новая задача будит спящий поток, а не ждет занятый
+        {
+            pool.Post([]() { std::this_thread::sleep_for(std::chrono::milliseconds(500)); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Остальные потоки засыпают
+            const auto start = std::chrono::steady_clock::now();
+            pool.Submit([]() {}).Get();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << "task behind a busy worker: " << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << " us" << std::endl;
+            assert(elapsed < std::chrono::milliseconds(100));
+        }
+        /// Исключение задачи Post не завершает программу, а учитывается в Failed()
+        pool.Post([]() { throw std::runtime_error("task failed"); });
+        /// Захват больше буфера задачи - функция хранится в куче
+        std::array<double, 16> coefficients{};
+        coefficients.fill(0.5);
+        [[maybe_unused]] const double sum = pool.Submit([coefficients]() { return std::accumulate(coefficients.begin(), coefficients.end(), 0.0); }).Get();
+        assert(sum == 8.0);
+        pool.Shutdown(); // Выполняет оставшиеся задачи и завершает потоки
+        assert(pool.Failed() == 1);
+        
+        /// Benchmark: 100000 мелких задач - одна очередь под одним mutex против очередей рабочих потоков с перехватом работы
+        struct MutexQueuePool
+        {
+            explicit MutexQueuePool(size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    threads.emplace_back([this]() { Run(); });
+            }
+            
+            ~MutexQueuePool()
+            {
+                {
+                    std::lock_guard lock(mutex);
+                    stop = true;
+                }
+                condition.notify_all();
+                for (auto& thread : threads)
+                    thread.join();
+            }
+            
+            void Post(InplaceCallback<void()>&& task)
+            {
+                {
+                    std::lock_guard lock(mutex);
+                    tasks.push(std::move(task));
+                }
+                condition.notify_one();
+            }
+            
+            void Run()
+            {
+                for (;;)
+                {
+                    std::unique_lock lock(mutex);
+                    condition.wait(lock, [this]() { return stop || !tasks.empty(); });
+                    if (tasks.empty())
+                        return;
+                    InplaceCallback<void()> task = std::move(tasks.front());
+                    tasks.pop();
+                    lock.unlock();
+                    task();
+                }
+            }
+            
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::queue<InplaceCallback<void()>> tasks;
+            bool stop = false;
+            std::vector<std::thread> threads;
+        };
+        
+        constexpr size_t count = 100'000;
+        for (size_t threads : {1, 2, 4, 8})
+        {
+            std::cout << threads << " threads:" << std::endl;
+            std::atomic<size_t> done = 0;
+            {
+                MutexQueuePool mutex_pool(threads);
+                benchmark::Measure("MutexQueuePool: 100000 tasks", 1, [&]()
+                {
+                    done = 0;
+                    for (size_t i = 0; i < count; ++i)
+                        mutex_pool.Post([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+                    while (done.load() != count)
+                        std::this_thread::yield();
+                });
+            }
+            {
+                ThreadPool stealing_pool(threads);
+                benchmark::Measure("ThreadPool: 100000 tasks", 1, [&]()
+                {
+                    done = 0;
+                    for (size_t i = 0; i < count; ++i)
+                        stealing_pool.Post([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+                    while (done.load() != count)
+                        std::this_thread::yield();
+                });
+                benchmark::Measure("ThreadPool: ParallelFor 100000 indices, grain 1", 1, [&]()
+                {
+                    done = 0;
+                    stealing_pool.ParallelFor(0, count, [&done](size_t) { done.fetch_add(1, std::memory_order_relaxed); });
+                });
+            }
+        }
+    }
+    // mpsc queue
+    {
+        using namespace callback;
+        std::cout << "mpsc queue" << std::endl;
+        
+        /// Поведение при заполненной очереди
+        MpscQueue<int, 4, Backpressure::Fail> fail_queue;
+        for (int i = 0; i < 4; ++i)
+            fail_queue.Push(i);
+        [[maybe_unused]] bool pushed = fail_queue.Push(4); // false: очередь заполнена
+        [[maybe_unused]] std::optional<int> first = fail_queue.TryPop(); // 0
+        MpscQueue<int, 4, Backpressure::Drop> drop_queue;
+        for (int i = 0; i < 5; ++i)
+            drop_queue.Push(i);
+        [[maybe_unused]] size_t dropped = drop_queue.Dropped(); // 1
+        
+        /// Задачи из многих потоков выполняет один поток-владелец, Drain забирает пачку задач
+        Example example;
+        CallbackRing<1024> ring;
+        std::thread producer([&]() { ring.Push(example, &Example::Method1, true); });
+        producer.join();
+        ring.Drain([](InplaceCallback<void()>&& task) { task(); }, 64);
+        
+        /*
+         Benchmark: producers потоков ставят задачи, 1 поток-владелец их выполняет; время - от старта до выполнения последней задачи.
+         Сравнение: std::queue<std::unique_ptr<ICallback>> под std::mutex (читатель забирает всю очередь за 1 блокировку) против CallbackRing (Backpressure::Block).
+         */
+        struct Counter
+        {
+            void Add(int value) { sum += value; }
+            long sum = 0;
+        };
+        auto run = [](std::string_view name, size_t producers, size_t count, auto&& post, auto&& drain)
+        {
+            const size_t total = producers * count;
+            const size_t allocations_before = benchmark::allocations.load();
+            const auto begin = std::chrono::steady_clock::now();
+            std::thread consumer([&]()
+            {
+                for (size_t executed = 0; executed < total;)
+                {
+                    const size_t drained = drain();
+                    executed += drained;
+                    if (drained == 0)
+                        std::this_thread::yield();
+                }
+            });
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < producers; ++i)
+            {
+                threads.emplace_back([&]()
+                {
+                    for (size_t j = 0; j < count; ++j)
+                        post();
+                });
+            }
+            for (auto& thread : threads)
+                thread.join();
+            consumer.join();
+            const auto finish = std::chrono::steady_clock::now();
+            std::cout << name << " (" << producers << " producers): " << std::chrono::duration<double, std::nano>(finish - begin).count() / double(total) << " ns/task, "
+                      << double(benchmark::allocations.load() - allocations_before) / double(total) << " allocations/task" << std::endl;
+        };
+        
+        constexpr size_t count = 10'000;
+        for (size_t producers : {1, 2, 4, 8, 16, 32})
+        {
+            Counter counter;
+            std::mutex mutex;
+            std::queue<std::unique_ptr<ICallback>> mutex_queue;
+            run("std::mutex + std::queue<unique_ptr<ICallback>>", producers, count, [&]()
+            {
+                std::unique_ptr<ICallback> task(new Callback(&counter, &Counter::Add, 1));
+                std::lock_guard lock(mutex);
+                mutex_queue.push(std::move(task));
+            }, [&]()
+            {
+                std::queue<std::unique_ptr<ICallback>> batch;
+                {
+                    std::lock_guard lock(mutex);
+                    std::swap(batch, mutex_queue);
+                }
+                const size_t drained = batch.size();
+                for (; !batch.empty(); batch.pop())
+                    (*batch.front())();
+                return drained;
+            });
+            
+            CallbackRing<1024> callback_ring;
+            run("CallbackRing<1024>", producers, count, [&]()
+            {
+                callback_ring.Push(counter, &Counter::Add, 1);
+            }, [&]()
+            {
+                return callback_ring.Drain([](InplaceCallback<void()>&& task) { task(); }, 256);
+            });
+        }
+    }
+    // timer wheel
+    {
+        using namespace callback;
+        using namespace std::chrono_literals;
+        std::cout << "timer wheel" << std::endl;
+        
+        /// Поток-драйвер вызывает callback по времени; периодический таймер переставляется без выделения памяти
+        Example example;
+        TimerWheel timers(1ms);
+        timers.Start();
+        timers.Schedule(5ms, InplaceCallback<void()>(&example, &Example::Method1, true));
+        auto periodic = timers.Schedule(1ms, std::unique_ptr<ICallback>(new Callback(&example, &Example::Method2, true, false)), 1ms);
+        std::this_thread::sleep_for(10ms);
+        timers.Cancel(periodic);
+        timers.Stop();
+        
+        /*
+         Benchmark: 100000 активных таймеров, колесо продвигается вручную (Advance) - время не зависит от часов.
+         Сравнение: упорядоченный контейнер std::multimap<тик, std::unique_ptr<ICallback>> (O(log n) на постановку) против TimerWheel (O(1)).
+         */
+        struct Counter
+        {
+            void Add(int value) { sum += value; }
+            long sum = 0;
+        };
+        Counter counter;
+        auto make_callback = [&counter]() { return std::unique_ptr<ICallback>(new Callback(&counter, &Counter::Add, 1)); };
+        constexpr size_t count = 100'000;
+        std::mt19937 random(42);
+        std::vector<uint64_t> delays(count);
+        for (auto& delay : delays)
+            delay = 1 + random() % 60'000;
+        
+        using Timers = std::multimap<uint64_t, std::unique_ptr<ICallback>>;
+        Timers multimap_timers;
+        uint64_t multimap_tick = 0;
+        for (uint64_t delay : delays)
+            multimap_timers.emplace(multimap_tick + delay, make_callback());
+        TimerWheel wheel;
+        for (uint64_t delay : delays)
+            wheel.Schedule(std::chrono::milliseconds(delay), make_callback());
+        
+        size_t index = 0;
+        benchmark::Measure("std::multimap: Schedule + Cancel (100000 active timers)", count, [&]()
+        {
+            Timers::iterator timer = multimap_timers.emplace(multimap_tick + delays[index++ % count], make_callback());
+            multimap_timers.erase(timer);
+        });
+        index = 0;
+        benchmark::Measure("TimerWheel: Schedule + Cancel (100000 active timers)", count, [&]()
+        {
+            TimerWheel::TimerId timer = wheel.Schedule(std::chrono::milliseconds(delays[index++ % count]), make_callback());
+            wheel.Cancel(timer);
+        });
+        
+        /// Срабатывание всех таймеров: время на 1 таймер
+        benchmark::Measure("std::multimap: fire 100000 timers", 1, [&]()
+        {
+            while (!multimap_timers.empty())
+            {
+                ++multimap_tick;
+                for (auto timer = multimap_timers.begin(); timer != multimap_timers.end() && timer->first <= multimap_tick; timer = multimap_timers.erase(timer))
+                    (*timer->second)();
+            }
+        });
+        benchmark::Measure("TimerWheel: fire 100000 timers", 1, [&]()
+        {
+            while (wheel.Size() != 0)
+                wheel.Advance(1);
+        });
+        
+        /// Периодические таймеры: 100000 таймеров с периодом 1-100 тиков, 1000 тиков
+        for (size_t i = 0; i < count; ++i)
+            wheel.Schedule(std::chrono::milliseconds(delays[i] % 100), InplaceCallback<void()>(&counter, &Counter::Add, 1), std::chrono::milliseconds(1 + delays[i] % 100));
+        benchmark::Measure("TimerWheel: 1000 ticks of 100000 periodic timers", 1, [&]() { wheel.Advance(1000); });
+    }
+    // coroutine
+    {
+        using namespace callback;
+        std::cout << "coroutine" << std::endl;
+        
+        /// Последовательность шагов через co_await вместо вложенных callback; лямбда-корутина должна жить до завершения задачи (захваты не копируются во фрейм)
+        Example example;
+        ThreadPool pool(1);
+        auto steps = [&]() -> Task<int>
+        {
+            co_await RunAsync(Permission(example, &Example::Method)); // Сразу в текущем потоке
+            Permission permission(example, &Example::Method1);
+            co_await RunAsync(pool, permission); // В потоке pool, продолжение - там же
+            co_return 42;
+        };
+        [[maybe_unused]] int result = SyncWait(steps());
+        
+        /// Benchmark: стоимость 1 co_await по сравнению с синхронным вызовом
+        struct Counter
+        {
+            void Add(int value) { sum += value; }
+            long sum = 0;
+        };
+        Counter counter;
+        std::unique_ptr<ICallback> callback(new Callback(&counter, &Counter::Add, 1));
+        auto measure_awaits = [](std::string_view name, size_t awaits, auto&& make_task)
+        {
+            const size_t allocations_before = benchmark::allocations.load();
+            const auto begin = std::chrono::steady_clock::now();
+            SyncWait(make_task());
+            const auto finish = std::chrono::steady_clock::now();
+            std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - begin).count() / double(awaits) << " ns/await, "
+                      << double(benchmark::allocations.load() - allocations_before) / double(awaits) << " allocations/await" << std::endl;
+        };
+        
+        constexpr size_t count = 1'000'000;
+        benchmark::Measure("ICallback: synchronous call", count, [&]() { (*callback)(); });
+        measure_awaits("co_await RunAsync(ICallback)", count, [&]() -> Task<void>
+        {
+            for (size_t i = 0; i < count; ++i)
+                co_await RunAsync(*callback);
+        });
+        auto child = [&]() -> Task<void>
+        {
+            (*callback)();
+            co_return;
+        };
+        measure_awaits("co_await Task (frame from FramePool, symmetric transfer)", count, [&]() -> Task<void>
+        {
+            for (size_t i = 0; i < count; ++i)
+                co_await child();
+        });
+        measure_awaits("co_await RunAsync(ThreadPool, ICallback)", 100'000, [&]() -> Task<void>
+        {
+            for (size_t i = 0; i < 100'000; ++i)
+                co_await RunAsync(pool, *callback);
+        });
+        
+        /// Выделение памяти фрейма: FramePool против глобальной кучи
+        benchmark::Measure("::operator new + delete (128 bytes)", count, [&]()
+        {
+            void* frame = ::operator new(128);
+            benchmark::DoNotOptimize(frame);
+            ::operator delete(frame);
+        });
+        benchmark::Measure("FramePool: Allocate + Deallocate (128 bytes)", count, [&]()
+        {
+            void* frame = FramePool::Allocate(128);
+            benchmark::DoNotOptimize(frame);
+            FramePool::Deallocate(frame, 128);
+        });
+    }
+    // signal
+    {
+        using namespace callback;
+        std::cout << "signal" << std::endl;
+        
+        /// Одно событие - много подписчиков: Permission, ICallback и методы объектов в одном списке
+        Example example;
+        Permission permission(example, &Example::Method);
+        std::unique_ptr<ICallback> callback(new Callback(&example, &Example::Method1, true));
+        Signal<> clicked;
+        clicked.Connect<&decltype(permission)::Run>(permission);
+        auto connection = clicked.Connect<&ICallback::operator()>(*callback);
+        clicked.Emit();
+        clicked.Disconnect(connection);
+        Signal<bool> toggled;
+        toggled.Connect<&Example::Method1>(example);
+        toggled.Emit(false);
+        
+        /*
+         Benchmark: 2 потока вызывают Emit, третий поток все время подключает и отключает слот (connect churn).
+         Сравнение: std::vector<Delegate> под std::mutex (Emit и подписка под одной блокировкой) против Signal (Emit без блокировки).
+         */
+        struct Sink
+        {
+            void On(int value) { benchmark::DoNotOptimize(value); }
+        };
+        struct MutexSignal
+        {
+            uint64_t Connect(Delegate<void(int)> slot)
+            {
+                std::lock_guard lock(mutex);
+                slots.emplace_back(++connections, slot);
+                return connections;
+            }
+            
+            void Disconnect(uint64_t connection)
+            {
+                std::lock_guard lock(mutex);
+                std::erase_if(slots, [connection](const auto& slot) { return slot.first == connection; });
+            }
+            
+            void Emit(int value)
+            {
+                std::lock_guard lock(mutex);
+                for (auto& [connection, slot] : slots)
+                    slot(value);
+            }
+            
+            std::mutex mutex;
+            std::vector<std::pair<uint64_t, Delegate<void(int)>>> slots;
+            uint64_t connections = 0;
+        };
+        auto with_churn = [](auto& signal, auto&& measure)
+        {
+            Sink sink;
+            std::atomic<bool> stop = false;
+            size_t churns = 0;
+            std::thread churn([&]()
+            {
+                for (; !stop.load(); ++churns)
+                    signal.Disconnect(signal.Connect(MakeDelegate<&Sink::On>(sink)));
+            });
+            measure();
+            stop = true;
+            churn.join();
+            std::cout << "  connect + disconnect during Emit: " << churns << std::endl;
+        };
+        
+        for (size_t slots : {1, 10, 1000})
+        {
+            std::cout << slots << " slots:" << std::endl;
+            std::vector<Sink> sinks(slots);
+            const size_t emits = 1'000'000 / slots + 1'000;
+            MutexSignal mutex_signal;
+            Signal<int> signal;
+            for (auto& sink : sinks)
+            {
+                mutex_signal.Connect(MakeDelegate<&Sink::On>(sink));
+                signal.Connect<&Sink::On>(sink);
+            }
+            with_churn(mutex_signal, [&]()
+            {
+                benchmark::MeasureParallel("std::mutex + std::vector<Delegate>: Emit", 2, emits, [&](size_t) { mutex_signal.Emit(1); });
+            });
+            with_churn(signal, [&]()
+            {
+                benchmark::MeasureParallel("Signal: Emit", 2, emits, [&](size_t) { signal.Emit(1); });
+            });
+        }
+    }
+    // dispatch
+    {
+        using namespace dispatch;
+        std::cout << "dispatch" << std::endl;
+        
+        /*
+         Benchmark: время 1 косвенного вызова (ns/op) для 5 способов вызова и 3 порядков операций, 4096 объектов по кругу.
+         Количество инструкций на вызов (instructions/call) - счетчик процессора InstructionCounter, только Linux; на других ОС и без доступа к счетчику - n/a
+         (там instructions/call измеряется вне программы: Instruments на macOS, VTune на Windows).
+         */
+        constexpr size_t size = 4096;
+        constexpr size_t calls = 10'000'000;
+        const std::pair<Pattern, std::string_view> patterns[] = {{Pattern::Monomorphic, "monomorphic"}, {Pattern::Predictable, "predictable"}, {Pattern::Random, "random"}};
+        for (const auto& [pattern, name] : patterns)
+        {
+            std::cout << name << ":" << std::endl;
+            Accumulator accumulator;
+            Operations operations(accumulator, MakeOperations(pattern, size));
+            benchmark::InstructionCounter instructions;
+            auto measure = [&](std::string_view mechanism, auto&& call)
+            {
+                size_t index = 0;
+                instructions.Start();
+                benchmark::Measure(mechanism, calls, [&]() { call(index++ & (size - 1)); });
+                std::cout << mechanism << ": ";
+                if (const std::optional<uint64_t> count = instructions.Stop())
+                    std::cout << double(*count) / double(calls) << " instructions/call" << std::endl;
+                else
+                    std::cout << "n/a instructions/call" << std::endl;
+            };
+            measure("virtual ICallback", [&](size_t index) { operations.Virtual(index); });
+            measure("std::function Callback", [&](size_t index) { operations.Function(index); });
+            measure("CRTP Base::Interface1 + switch", [&](size_t index) { operations.Static(index); });
+            measure("std::visit Match", [&](size_t index) { operations.Visit(index); });
+            measure("std::invoke CallInvoke", [&](size_t index) { operations.Invoke(index); });
+            benchmark::DoNotOptimize(accumulator.sum);
+        }
     }
     /*
      Метафункция - это шаблонная (template) структура с constexpr членами, которые вычисляются во время компиляции.
@@ -707,6 +1327,21 @@ int main()
         [[maybe_unused]] auto& singleton1 = CRTP::SINGLETON::Singleton1::Instance();
         [[maybe_unused]] auto& singleton2 = CRTP::SINGLETON::Singleton2::Instance();
         
+        /// Способы создания синглтона: Lazy (синглтон Майерса), Eager (constinit), ThreadLocal, Explicit (Init/Shutdown)
+        {
+            using namespace CRTP::SINGLETON;
+            ExplicitSingleton::Init();
+            constexpr size_t iterations = 10'000'000;
+            for (size_t threads : {1, 2, 4, 8, 16})
+            {
+                benchmark::MeasureParallel("Lazy: Instance()", threads, iterations, [](size_t) { benchmark::DoNotOptimize(&Singleton1::Instance()); });
+                benchmark::MeasureParallel("Eager: Instance()", threads, iterations, [](size_t) { benchmark::DoNotOptimize(&EagerSingleton::Instance()); });
+                benchmark::MeasureParallel("ThreadLocal: Instance()", threads, iterations, [](size_t) { benchmark::DoNotOptimize(&ThreadLocalSingleton::Instance()); });
+                benchmark::MeasureParallel("Explicit: Instance()", threads, iterations, [](size_t) { benchmark::DoNotOptimize(&ExplicitSingleton::Instance()); });
+            }
+            Lifetime::ShutdownAll(); // Explicit синглтоны уничтожаются в порядке, обратном Init
+        }
+        
         CRTP::Variadic<CRTP::Counter, CRTP::Equal, CRTP::Compare> variadic1(10);
         CRTP::Variadic<CRTP::Counter, CRTP::Equal, CRTP::Compare> variadic2(20);
         CRTP::Variadic<CRTP::Counter, CRTP::Equal, CRTP::Compare> variadic3(10);
@@ -717,6 +1352,90 @@ int main()
         [[maybe_unused]] auto compare4 = variadic1 > variadic2;
         [[maybe_unused]] auto compare5 = variadic1 == variadic3;
         [[maybe_unused]] auto compare6 = variadic1 != variadic3;
+        
+        /// Счетчики живых объектов всех типов с CRTP::Counter и mixins::Counter
+        [[maybe_unused]] size_t variadic_count = CRTP::Counter<decltype(variadic1)>::count(); // 3
+        telemetry::CounterRegistry::Instance().Dump(std::cout);
+        
+        /// Benchmark: создание и уничтожение объекта в threads потоках - общий std::atomic против ShardedCounter
+        std::atomic<size_t> shared_counter = 0;
+        telemetry::ShardedCounter sharded_counter;
+        for (size_t threads : {1, 2, 4, 8, 16})
+        {
+            benchmark::MeasureParallel("std::atomic: increment + decrement", threads, 1'000'000, [&](size_t)
+            {
+                shared_counter.fetch_add(1, std::memory_order_relaxed);
+                shared_counter.fetch_sub(1, std::memory_order_relaxed);
+            });
+            benchmark::MeasureParallel("ShardedCounter: increment + decrement", threads, 1'000'000, [&](size_t)
+            {
+                sharded_counter.Increment();
+                sharded_counter.Decrement();
+            });
+        }
+    }
+    /*
+     Expression templates (шаблоны выражений) - CRTP для арифметики над массивами: a + b * c - d возвращает не результат, а дерево выражения, которое вычисляется при присваивании одним циклом.
+     Наивная реализация создает временный массив на каждый оператор: b * c, a + (b * c), (a + b * c) - d - три выделения памяти и три прохода по памяти.
+    */
+    {
+        using namespace CRTP::expression;
+        std::cout << "expression templates" << std::endl;
+        
+        Vector<double> a = {1, 2, 3}, b = {4, 5, 6}, c = {7, 8, 9}, d = {1, 1, 1};
+        Vector<double> result = a + b * c - d; // {28, 41, 56}
+        result = result / 2.0 + 2.0 * a;       // {16, 24.5, 34}
+        auto expression = a + b * c;           // Binary<std::plus<>, Vector<double>, Binary<std::multiplies<>, Vector<double>, Vector<double>>>: еще не вычислено
+        [[maybe_unused]] double element = expression[1]; // 42: вычисляется только один элемент
+        try
+        {
+            result = a + Vector<double>(2);
+        }
+        catch (const std::invalid_argument& exception)
+        {
+            std::cout << exception.what() << std::endl;
+        }
+        
+        /// Benchmark: a + b * c - d - временный массив на каждый оператор против одного цикла
+        const auto naive = [](const std::vector<double>& a, const std::vector<double>& b, const std::vector<double>& c, const std::vector<double>& d)
+        {
+            const auto apply = [](const std::vector<double>& left, const std::vector<double>& right, auto operation)
+            {
+                std::vector<double> result(left.size());
+                for (size_t i = 0; i < left.size(); ++i)
+                    result[i] = operation(left[i], right[i]);
+                return result;
+            };
+            return apply(apply(a, apply(b, c, std::multiplies<>()), std::plus<>()), d, std::minus<>());
+        };
+        
+        for (size_t size : {1'000, 1'000'000})
+        {
+            const size_t iterations = 100'000'000 / size;
+            std::vector<double> values[4];
+            Vector<double> vectors[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                values[i].resize(size);
+                for (size_t j = 0; j < size; ++j)
+                    values[i][j] = double(i + j % 100);
+                vectors[i] = Vector<double>(size);
+                std::copy(values[i].begin(), values[i].end(), vectors[i].begin());
+            }
+            std::vector<double> naive_result;
+            Vector<double> fused_result(size);
+            std::cout << "size: " << size << std::endl;
+            benchmark::Measure("temporaries: a + b * c - d", iterations, [&]()
+            {
+                naive_result = naive(values[0], values[1], values[2], values[3]);
+                benchmark::DoNotOptimize(naive_result.data());
+            });
+            benchmark::Measure("expression template: a + b * c - d", iterations, [&]()
+            {
+                fused_result = vectors[0] + vectors[1] * vectors[2] - vectors[3];
+                benchmark::DoNotOptimize(fused_result.data());
+            });
+        }
     }
     /*
      SFINAE (substitution failure is not an error) - при определении перегрузок функции ошибочные подстановки в шаблоны не вызывают ошибку компиляции, а отбрасываются из списка кандидатов на наиболее подходящую перегрузку.
@@ -1044,6 +1763,10 @@ int main()
             [[maybe_unused]] auto value_double = Get<1>(tuple);
             [[maybe_unused]] auto value_char = Get<2>(tuple);
             [[maybe_unused]] auto value_string = Get<3>(tuple);
+            [[maybe_unused]] auto& reference_string = Get<3>(tuple); // Ссылка, без копирования
+            [[maybe_unused]] auto& type_string = Get<std::string>(tuple); // Get по типу
+            [[maybe_unused]] auto move_string = Get<3>(std::move(tuple_deduction1)); // rvalue: перемещение
+            [[maybe_unused]] auto& [binding_int, binding_double, binding_char, binding_string] = tuple; // Structured binding
             [[maybe_unused]] auto make_tuple = Make_Tuple(1, 10.0, 'c');
             [[maybe_unused]] auto size = tuple.Size();
             [[maybe_unused]] auto ebo1 = sizeof(Tuple<dummy<0>, dummy<1>, dummy<2>>); // 1
@@ -1065,6 +1788,10 @@ int main()
             [[maybe_unused]] auto value_double = Get<1>(tuple);
             [[maybe_unused]] auto value_char = Get<2>(tuple);
             [[maybe_unused]] auto value_string = Get<3>(tuple);
+            [[maybe_unused]] auto& reference_string = Get<3>(tuple); // Ссылка, без копирования
+            [[maybe_unused]] auto& type_string = Get<std::string>(tuple); // Get по типу
+            [[maybe_unused]] auto move_string = Get<3>(std::move(tuple_deduction1)); // rvalue: перемещение
+            [[maybe_unused]] auto& [binding_int, binding_double, binding_char, binding_string] = tuple; // Structured binding
             [[maybe_unused]] auto make_tuple = Make_Tuple(1, 10.0, 'c');
             [[maybe_unused]] auto size = tuple.Size();
             [[maybe_unused]] auto ebo1 = sizeof(Tuple<dummy<0>, dummy<1>, dummy<2>>); // 1
@@ -1086,16 +1813,447 @@ int main()
             [[maybe_unused]] auto value_double = Get<1>(tuple);
             [[maybe_unused]] auto value_char = Get<2>(tuple);
             [[maybe_unused]] auto value_string = Get<3>(tuple);
+            [[maybe_unused]] auto& type_string = Get<std::string>(tuple); // Get по типу
+            [[maybe_unused]] auto& [binding_int, binding_double, binding_char, binding_string] = tuple; // Structured binding
             [[maybe_unused]] auto make_tuple = Make_Tuple(1, 10.0, 'c');
             [[maybe_unused]] auto size = tuple.Size();
             [[maybe_unused]] auto ebo1 = sizeof(Tuple<dummy<0>, dummy<1>, dummy<2>>); // 1
             [[maybe_unused]] auto ebo2 = sizeof(Tuple<dummy<0>, dummy<0>, dummy<0>>); // 3
             
+            /// Политика расположения AlignmentLayout: листья упорядочены по убыванию выравнивания, Get<index> сохраняет порядок объявления
+            static_assert(sizeof(BasicTuple<AlignmentLayout, char, double, char, int>) < sizeof(Tuple<char, double, char, int>), "AlignmentLayout must remove padding");
+            [[maybe_unused]] auto padding1 = sizeof(Tuple<char, double, char, int>); // 24
+            [[maybe_unused]] auto padding2 = sizeof(BasicTuple<AlignmentLayout, char, double, char, int>); // 16
+            [[maybe_unused]] auto padding3 = sizeof(Tuple<bool, double, bool, int, bool>); // 32
+            [[maybe_unused]] auto padding4 = sizeof(BasicTuple<AlignmentLayout, bool, double, bool, int, bool>); // 16
+            BasicTuple<AlignmentLayout, char, double, char, int> aligned_tuple('a', 10.0, 'b', 1);
+            [[maybe_unused]] auto aligned_char = Get<0>(aligned_tuple); // 'a'
+            [[maybe_unused]] auto aligned_int = Get<3>(aligned_tuple); // 1
+            
             [[maybe_unused]] auto make_ref_tuple = Make_Ref_Tuple(value_int, value_double, value_char, value_string);
             Get<0>(make_ref_tuple) = 10;
             Get<1>(make_ref_tuple) = 100.0;
             Get<2>(make_ref_tuple) = 'C';
             Get<3>(make_ref_tuple) = "ABC";
+            
+            /// Идеальная передача (perfect forwarding) и кусочное (piecewise) конструирование: временные объекты перемещаются, элементы конструируются на месте
+            Tuple<std::string, std::vector<int>> piecewise(Piecewise(), Forward_As_Tuple(3, 'a'), Forward_As_Tuple(10, 1)); // "aaa", {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}
+            Tuple<long, std::string> converted(Tuple<int, const char*>(1, "abc")); // Преобразующее перемещение
+            
+            /// Compile-time benchmark: MakeIndexSequence с глубиной O(log N) - Tuple из 256 и 1024 элементов (рекурсия по одному индексу упиралась в глубину инстанцирования). Время и память компилятора: clang++ -ftime-trace, g++ -ftime-report
+            {
+                auto make_large_tuple = []<size_t... index>(IndexSequence<index...>) { return Tuple<decltype(index)...>(); };
+                using Tuple256 = decltype(make_large_tuple(MakeIndexSequence<256>()));
+                using Tuple1024 = decltype(make_large_tuple(MakeIndexSequence<1024>()));
+                static_assert(Tuple256::value == 256, "must be 256");
+                static_assert(Tuple1024::value == 1024, "must be 1024");
+                [[maybe_unused]] auto size256 = sizeof(Tuple256); // 256 * 8
+                [[maybe_unused]] auto size1024 = sizeof(Tuple1024); // 1024 * 8
+            }
+        }
+        /// constexpr: конструирование, Get и Make_Tuple вычисляются во время компиляции - таблица записей лежит в .rodata, без статической инициализации при запуске
+        {
+            constexpr first_implementation::Tuple<int, double, char> first(1, 2.0, 'a');
+            constexpr auto first_make_tuple = first_implementation::Make_Tuple(1, 2.0);
+            static_assert(first_implementation::Get<2>(first) == 'a' && first_implementation::Get<double>(first) == 2.0 && first_implementation::Get<0>(first_make_tuple) == 1);
+            
+            constexpr second_implementation::Tuple<int, double, char> second(1, 2.0, 'b');
+            constexpr auto second_make_tuple = second_implementation::Make_Tuple(1, 2.0);
+            static_assert(second_implementation::Get<2>(second) == 'b' && second_implementation::Get<double>(second) == 2.0 && second_implementation::Get<0>(second_make_tuple) == 1);
+            
+            constexpr third_implementation::Tuple<int, double, char> third(1, 2.0, 'c');
+            constexpr auto third_make_tuple = third_implementation::Make_Tuple(1, 2.0);
+            constexpr third_implementation::BasicTuple<third_implementation::AlignmentLayout, char, double> third_alignment('d', 3.0);
+            static_assert(third_implementation::Get<2>(third) == 'c' && third_implementation::Get<double>(third) == 2.0 && third_implementation::Get<0>(third_make_tuple) == 1);
+            static_assert(third_implementation::Get<0>(third_alignment) == 'd' && third_implementation::Get<1>(TupleCat(third, third_make_tuple)) == 2.0);
+            
+            static constexpr std::array<third_implementation::Tuple<int, double, char>, 3> table =
+            {
+                third_implementation::Tuple<int, double, char>(1, 10.0, 'a'),
+                third_implementation::Tuple<int, double, char>(2, 20.0, 'b'),
+                third_implementation::Tuple<int, double, char>(3, 30.0, 'c')
+            };
+            static_assert(Fold(table[2], 0.0, [](double sum, auto value) { return sum + value; }) == 3 + 30.0 + 'c');
+        }
+        /// Benchmark: Get возвращает ссылку - доступ к std::string не выделяет память (0 allocations/op), копия - 1 allocation/op
+        {
+            std::cout << "tuple benchmark" << std::endl;
+            
+            const std::string text(64, 'x'); // Строка длиннее SSO (small string optimization): копия выделяет память в куче
+            first_implementation::Tuple<int, double, char, std::string> tuple1(1, 10.0, 'c', text);
+            second_implementation::Tuple<int, double, char, std::string> tuple2(1, 10.0, 'c', text);
+            third_implementation::Tuple<int, double, char, std::string> tuple3(1, 10.0, 'c', text);
+            constexpr size_t iterations = 1'000'000;
+            
+            benchmark::Measure("first_implementation::Get<3>", iterations, [&]() { benchmark::DoNotOptimize(first_implementation::Get<3>(tuple1).size()); });
+            benchmark::Measure("second_implementation::Get<3>", iterations, [&]() { benchmark::DoNotOptimize(second_implementation::Get<3>(tuple2).size()); });
+            benchmark::Measure("third_implementation::Get<3>", iterations, [&]() { benchmark::DoNotOptimize(third_implementation::Get<3>(tuple3).size()); });
+            benchmark::Measure("std::string copy", iterations, [&]() { std::string copy = first_implementation::Get<3>(tuple1); benchmark::DoNotOptimize(copy); });
+            
+            /// Конструирование из временных объектов: 1 allocation/op - только сам временный std::string, в tuple он перемещается без копии
+            benchmark::Measure("third_implementation::Tuple from temporary", iterations, [&]()
+            {
+                third_implementation::Tuple<std::string> temporary{std::string(text)};
+                benchmark::DoNotOptimize(temporary);
+            });
+            benchmark::Measure("third_implementation::Make_Tuple", iterations, [&]()
+            {
+                auto make_tuple = third_implementation::Make_Tuple(std::string(text), 1);
+                benchmark::DoNotOptimize(make_tuple);
+            });
+            benchmark::Measure("third_implementation::Tuple piecewise", iterations, [&]()
+            {
+                third_implementation::Tuple<std::string> piecewise(third_implementation::Piecewise(), third_implementation::Forward_As_Tuple(text.size(), 'x'));
+                benchmark::DoNotOptimize(piecewise);
+            });
+            
+            /// Проверка: ровно 1 выделение памяти на конструирование (сам std::string) - временный объект перемещается, а не копируется
+            const auto count_allocations = [](auto&& function)
+            {
+                const size_t before = benchmark::allocations.load();
+                function();
+                return benchmark::allocations.load() - before;
+            };
+            [[maybe_unused]] const size_t from_temporary = count_allocations([&]()
+            {
+                third_implementation::Tuple<std::string> temporary{std::string(text)};
+                benchmark::DoNotOptimize(temporary);
+            });
+            [[maybe_unused]] const size_t from_make_tuple = count_allocations([&]()
+            {
+                auto make_tuple = third_implementation::Make_Tuple(std::string(text), 1);
+                benchmark::DoNotOptimize(make_tuple);
+            });
+            [[maybe_unused]] const size_t from_piecewise = count_allocations([&]()
+            {
+                third_implementation::Tuple<std::string> piecewise(third_implementation::Piecewise(), third_implementation::Forward_As_Tuple(text.size(), 'x'));
+                benchmark::DoNotOptimize(piecewise);
+            });
+            assert(from_temporary == 1);
+            assert(from_make_tuple == 1);
+            assert(from_piecewise == 1);
+        }
+        /// Алгоритмы ForEach, Transform, Fold, Zip - работают со всеми тремя реализациями, разворачиваются в линейный код без рекурсии
+        {
+            std::cout << "tuple algorithms" << std::endl;
+            
+            third_implementation::Tuple<int, double, char, std::string> tuple(1, 10.0, 'c', "abc");
+            first_implementation::Tuple<int, double, char, std::string> other(2, 20.0, 'd', "def");
+            
+            ForEach(tuple, [](const auto& value) { std::cout << value << " "; });
+            std::cout << std::endl;
+            [[maybe_unused]] auto transform = Transform(tuple, [](const auto& value) { return sizeof(value); }); // Tuple<size_t, size_t, size_t, size_t>
+            [[maybe_unused]] auto fold = Fold(transform, size_t(0), [](size_t sum, size_t value) { return sum + value; }); // 4 + 8 + 1 + 32
+            [[maybe_unused]] auto zip = Zip(other, tuple); // first_implementation::Tuple<Tuple<int&, int&>, Tuple<double&, double&>, ...>
+            Get<1>(Get<0>(zip)) = 3; // tuple: 3, 10.0, 'c', "abc"
+            
+            /// TupleCat: элементы rvalue tuple перемещаются сразу в итоговый tuple, элементы lvalue tuple - копируются
+            third_implementation::Tuple<std::string, std::string> strings(std::string(64, 'a'), std::string(64, 'b'));
+            const size_t allocations = benchmark::allocations;
+            [[maybe_unused]] auto cat = TupleCat(std::move(strings), other, third_implementation::Tuple<long>(4L)); // Tuple<std::string, std::string, int, double, char, std::string, long>
+            std::cout << "TupleCat allocations: " << benchmark::allocations - allocations << std::endl; // 0: строки из strings перемещены, "def" из other - в SSO
+        }
+        /// TupleVector - хранение по столбцам (struct of arrays): проход по одному полю не загружает в кэш остальные поля записи
+        {
+            using namespace third_implementation;
+            std::cout << "tuple vector" << std::endl;
+            
+            TupleVector<int, double, char, std::string> records;
+            records.reserve(2);
+            records.push_back(1, 10.0, 'c', "abc");
+            records.emplace_back(2, 20.0, 'd', std::string("def"));
+            auto row = records[0]; // Tuple<int&, double&, char&, std::string&>
+            Get<1>(row) = 100.0;
+            auto& [row_int, row_double, row_char, row_string] = row;
+            row_string = "ABC";
+            [[maybe_unused]] auto column = records.Column<1>(); // std::span<double>: 100.0, 20.0
+            
+            /// Benchmark: сумма одного поля - array of structs против struct of arrays
+            constexpr size_t count = 1'000'000;
+            std::vector<Tuple<int, double, char, std::string>> array_of_structs;
+            TupleVector<int, double, char, std::string> struct_of_arrays;
+            array_of_structs.reserve(count);
+            struct_of_arrays.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                array_of_structs.emplace_back(int(i), double(i), 'c', "abc");
+                struct_of_arrays.push_back(int(i), double(i), 'c', "abc");
+            }
+            
+            benchmark::Measure("array of structs: sum of column", 10, [&]()
+            {
+                double sum = 0.0;
+                for (const auto& record : array_of_structs)
+                    sum += Get<1>(record);
+                benchmark::DoNotOptimize(sum);
+            });
+            benchmark::Measure("struct of arrays: sum of column", 10, [&]()
+            {
+                double sum = 0.0;
+                for (double value : struct_of_arrays.Column<1>())
+                    sum += value;
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        /// Сравнение и хеширование: Tuple как ключ std::unordered_map и std::map
+        {
+            std::cout << "tuple comparison" << std::endl;
+            
+            first_implementation::Tuple<int, std::string> first(1, std::string("abc"));
+            second_implementation::Tuple<long, std::string_view> second(1L, std::string_view("abd"));
+            third_implementation::Tuple<int, int, int> third(1, 2, 3);
+            [[maybe_unused]] bool equal = first == first_implementation::Tuple<long, std::string_view>(1L, std::string_view("abc")); // true: разные типы элементов, равные значения
+            [[maybe_unused]] bool less = second < second_implementation::Tuple<int, std::string>(1, std::string("abe")); // true: "abd" < "abe"
+            [[maybe_unused]] auto order = third <=> third_implementation::Tuple<int, int, int>(1, 2, 4); // std::strong_ordering::less
+            [[maybe_unused]] bool bytewise = IsBytewiseComparable<third_implementation::BasicTuple<third_implementation::DeclarationLayout, int, int, int>,
+                                                                  third_implementation::BasicTuple<third_implementation::DeclarationLayout, int, int, int>>; // true: == через memcmp
+            
+            /// Элемент только с operator< (без <=>): сравнение через два вызова <, результат - std::weak_ordering
+            struct Version
+            {
+                int major;
+                bool operator<(const Version& other) const { return major < other.major; }
+            };
+            using Release = first_implementation::Tuple<std::string, Version>;
+            static_assert(std::is_same_v<decltype(std::declval<Release>() <=> std::declval<Release>()), std::weak_ordering>);
+            assert(Release(std::string("lib"), Version{1}) < Release(std::string("lib"), Version{2}));
+            assert(!(Release(std::string("lib"), Version{2}) < Release(std::string("lib"), Version{1})));
+            
+            /// Heterogeneous lookup: поиск по Tuple<std::string_view, int> без создания std::string
+            std::unordered_map<third_implementation::Tuple<std::string, int>, int, Hash, std::equal_to<>> names;
+            names.emplace(third_implementation::Tuple<std::string, int>(std::string(64, 'a'), 1), 1);
+            const size_t allocations = benchmark::allocations;
+            [[maybe_unused]] auto found = names.find(third_implementation::Tuple<std::string_view, int>(std::string_view(Get<0>(names.begin()->first)), 1));
+            std::cout << "heterogeneous lookup allocations: " << benchmark::allocations - allocations << std::endl; // 0
+            
+            /// Benchmark: вставка и поиск - ключи Tuple против std::tuple
+            struct StdTupleHash
+            {
+                size_t operator()(const std::tuple<int, int, int>& key) const noexcept
+                {
+                    return std::apply([](const auto&... value)
+                    {
+                        size_t seed = 0;
+                        ((seed = (seed ^ std::hash<int>()(value)) * 0x9E3779B97F4A7C15ull + (seed >> 29)), ...);
+                        return seed;
+                    }, key);
+                }
+            };
+            
+            constexpr int count = 100'000;
+            benchmark::Measure("std::tuple key: insert + find", 10, [&]()
+            {
+                std::unordered_map<std::tuple<int, int, int>, int, StdTupleHash> map;
+                map.reserve(count);
+                for (int i = 0; i < count; ++i)
+                    map.emplace(std::tuple<int, int, int>(i, i >> 3, i & 7), i);
+                size_t sum = 0;
+                for (int i = 0; i < count; ++i)
+                    sum += map.find(std::tuple<int, int, int>(i, i >> 3, i & 7))->second;
+                benchmark::DoNotOptimize(sum);
+            });
+            benchmark::Measure("Tuple key: insert + find", 10, [&]()
+            {
+                std::unordered_map<third_implementation::Tuple<int, int, int>, int, Hash> map;
+                map.reserve(count);
+                for (int i = 0; i < count; ++i)
+                    map.emplace(third_implementation::Tuple<int, int, int>(i, i >> 3, i & 7), i);
+                size_t sum = 0;
+                for (int i = 0; i < count; ++i)
+                    sum += map.find(third_implementation::Tuple<int, int, int>(i, i >> 3, i & 7))->second;
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        /// Двоичная запись Tuple в файл и чтение через отображение файла в память без копирования
+        {
+            using namespace serialization;
+            std::cout << "tuple serialization" << std::endl;
+            
+            const std::string fixed_path = (std::filesystem::temp_directory_path() / "tuple_fixed.bin").string();
+            const std::string text_path = (std::filesystem::temp_directory_path() / "tuple_text.txt").string();
+            const std::string strings_path = (std::filesystem::temp_directory_path() / "tuple_strings.bin").string();
+            constexpr int count = 1'000'000;
+            
+            {
+                RecordWriter<int, double, char, std::string> writer(strings_path);
+                writer.Write(third_implementation::Tuple<int, double, char, std::string>(1, 10.0, 'c', "abc"));
+                writer.Write(first_implementation::Tuple<int, double, char, std::string_view>(2, 20.0, 'd', std::string_view("def")));
+            }
+            {
+                RecordWriter<int, double, char, std::string> writer(strings_path, Mode::Append); // Дописывание в конец файла
+                writer.Write(second_implementation::Tuple<int, double, char, std::string>(3, 30.0, 'e', "ghi"));
+            }
+            for (const auto& [int_value, double_value, char_value, string_value] : RecordReader<int, double, char, std::string>(strings_path))
+                std::cout << int_value << " " << double_value << " " << char_value << " " << string_value << std::endl; // string_value - std::string_view в отображение файла
+            
+            /// Benchmark: запись и чтение - iostreams против двоичного формата
+            benchmark::Measure("iostream: write", 1, [&]()
+            {
+                std::ofstream file(text_path);
+                for (int i = 0; i < count; ++i)
+                    file << i << ' ' << double(i) << ' ' << char('a' + i % 26) << '\n';
+            });
+            benchmark::Measure("RecordWriter: write", 1, [&]()
+            {
+                RecordWriter<int, double, char> writer(fixed_path);
+                for (int i = 0; i < count; ++i)
+                    writer.Write(third_implementation::Tuple<int, double, char>(i, double(i), char('a' + i % 26)));
+            });
+            benchmark::Measure("iostream: read", 1, [&]()
+            {
+                std::ifstream file(text_path);
+                int int_value;
+                double double_value, sum = 0.0;
+                char char_value;
+                while (file >> int_value >> double_value >> char_value)
+                    sum += double_value;
+                benchmark::DoNotOptimize(sum);
+            });
+            benchmark::Measure("RecordReader: read", 1, [&]()
+            {
+                RecordReader<int, double, char> reader(fixed_path);
+                double sum = 0.0;
+                for (size_t i = 0; i < reader.size(); ++i)
+                    sum += third_implementation::Get<1>(reader[i]);
+                benchmark::DoNotOptimize(sum);
+            });
+            
+            /// Запись <int, double, char> - 24 байта с выравниванием 8: файл, обрезанный на 8 байт, кратен выравниванию, но не размеру записи
+            std::filesystem::resize_file(fixed_path, std::filesystem::file_size(fixed_path) - 8);
+            [[maybe_unused]] bool rejected = false;
+            try
+            {
+                RecordWriter<int, double, char> writer(fixed_path, Mode::Append);
+            }
+            catch (const std::runtime_error&)
+            {
+                rejected = true;
+            }
+            assert(rejected);
+            
+            std::filesystem::remove(fixed_path);
+            std::filesystem::remove(text_path);
+            std::filesystem::remove(strings_path);
+        }
+        /// PackedTuple - битовые поля с шириной в non-type template параметре: Get/Set - сдвиг и маска
+        {
+            using namespace packed;
+            std::cout << "packed tuple" << std::endl;
+            
+            using Packed = PackedTuple<Field<uint32_t, 12>, Field<bool, 1>, Field<uint8_t, 3>>;
+            using Unpacked = third_implementation::Tuple<uint32_t, bool, uint8_t>;
+            static_assert(sizeof(Packed) == 2); // 12 + 1 + 3 = 16 бит в одном слове uint16_t
+            static_assert(sizeof(Unpacked) == 8);
+            
+            Packed packed(100u, true, 5);
+            Set<0>(packed, 4095u);
+            [[maybe_unused]] auto [counter, flag, level] = packed; // 4095, true, 5 - по значению
+            
+            /// Алгоритмы из TupleAlgorithm.h возвращают обычный Tuple
+            [[maybe_unused]] auto doubled = Transform(packed, [](auto value) { return int(value) * 2; }); // 8190, 2, 10
+            [[maybe_unused]] auto zipped = Zip(packed, packed); // Tuple<Tuple<uint32_t, uint32_t>, Tuple<bool, bool>, Tuple<uint8_t, uint8_t>>
+            static_assert(std::is_same_v<decltype(doubled), third_implementation::Tuple<int, int, int>>);
+            static_assert(std::is_same_v<decltype(zipped), third_implementation::Tuple<third_implementation::Tuple<uint32_t, uint32_t>, third_implementation::Tuple<bool, bool>, third_implementation::Tuple<uint8_t, uint8_t>>>);
+            
+            /// Benchmark: память и проход с чтением и записью полей
+            constexpr size_t count = 1'000'000;
+            std::vector<Packed> packed_records(count, Packed(1u, true, 3));
+            std::vector<Unpacked> unpacked_records(count, Unpacked(1u, true, 3));
+            std::cout << "PackedTuple: " << sizeof(Packed) * count << " bytes, Tuple: " << sizeof(Unpacked) * count << " bytes" << std::endl;
+            
+            benchmark::Measure("Tuple: increment counter", 10, [&]()
+            {
+                for (auto& record : unpacked_records)
+                {
+                    if (third_implementation::Get<1>(record))
+                        third_implementation::Get<0>(record) = (third_implementation::Get<0>(record) + third_implementation::Get<2>(record)) & 4095u;
+                }
+                benchmark::DoNotOptimize(unpacked_records.data());
+            });
+            benchmark::Measure("PackedTuple: increment counter", 10, [&]()
+            {
+                for (auto& record : packed_records)
+                {
+                    if (Get<1>(record))
+                        Set<0>(record, Get<0>(record) + Get<2>(record));
+                }
+                benchmark::DoNotOptimize(packed_records.data());
+            });
+        }
+        /// Record - именованные поля: Get<"name"> вычисляет индекс поля во время компиляции
+        {
+            using namespace record;
+            std::cout << "record" << std::endl;
+            
+            using Person = Record<Field<"id", int>, Field<"name", std::string>, Field<"score", double>>;
+            Person person(1, std::string("Bob"), 4.5);
+            Get<"score">(person) = 5.0;
+            [[maybe_unused]] auto& [id, name, score] = person; // 1, "Bob", 5.0
+            [[maybe_unused]] auto field_name = Person::names[1]; // "name"
+            
+            /// Алгоритмы из TupleAlgorithm.h возвращают обычный Tuple
+            [[maybe_unused]] auto sizes = Transform(person, [](const auto& value) { return sizeof(value); });
+            [[maybe_unused]] auto zipped = Zip(person, person); // Tuple<Tuple<int&, int&>, Tuple<std::string&, std::string&>, Tuple<double&, double&>>
+            static_assert(std::is_same_v<decltype(sizes), third_implementation::Tuple<size_t, size_t, size_t>>);
+            static_assert(std::is_same_v<decltype(zipped), third_implementation::Tuple<third_implementation::Tuple<int&, int&>, third_implementation::Tuple<std::string&, std::string&>, third_implementation::Tuple<double&, double&>>>);
+            
+            /// Benchmark: чтение полей - std::map<std::string, std::any> против Record
+            std::map<std::string, std::any> map_person{{"id", 1}, {"name", std::string("Bob")}, {"score", 4.5}};
+            constexpr size_t count = 1'000'000;
+            benchmark::Measure("std::map<std::string, std::any>: Get", count, [&]()
+            {
+                const double result = std::any_cast<int>(map_person["id"]) + std::any_cast<const std::string&>(map_person["name"]).size() + std::any_cast<double>(map_person["score"]);
+                benchmark::DoNotOptimize(result);
+            });
+            benchmark::Measure("Record: Get<\"name\">", count, [&]()
+            {
+                benchmark::DoNotOptimize(person);
+                const double result = Get<"id">(person) + Get<"name">(person).size() + Get<"score">(person);
+                benchmark::DoNotOptimize(result);
+            });
+        }
+        /// SharedTuple - seqlock: читатели получают согласованную копию без блокировок и без записи в общую память
+        {
+            using namespace third_implementation;
+            std::cout << "shared tuple" << std::endl;
+            
+            using Config = Tuple<int, double, long>;
+            SharedTuple<int, double, long> shared(Config(1, 1.0, 1L));
+            shared.Store(Config(2, 2.0, 2L));
+            shared.Update([](Config& config) { ++Get<0>(config); }); // 3, 2.0, 2
+            [[maybe_unused]] Config snapshot = shared.Load();
+            
+            /// Benchmark: масштабирование читателей (1-32 потока) при редкой записи - seqlock против std::mutex
+            std::mutex mutex;
+            Config locked(1, 1.0, 1L);
+            for (size_t threads : {1, 2, 4, 8, 16, 32})
+            {
+                std::atomic<bool> stop = false;
+                std::thread writer([&]()
+                {
+                    for (long i = 0; !stop.load(std::memory_order_relaxed); ++i)
+                    {
+                        shared.Store(Config(int(i), double(i), i));
+                        {
+                            std::lock_guard lock(mutex);
+                            locked = Config(int(i), double(i), i);
+                        }
+                        std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    }
+                });
+                benchmark::MeasureParallel("std::mutex: Load", threads, 100'000, [&](size_t)
+                {
+                    std::lock_guard lock(mutex);
+                    benchmark::DoNotOptimize(Get<0>(locked) + Get<2>(locked));
+                });
+                benchmark::MeasureParallel("SharedTuple: Load", threads, 100'000, [&](size_t)
+                {
+                    const Config config = shared.Load();
+                    benchmark::DoNotOptimize(Get<0>(config) + Get<2>(config));
+                });
+                stop = true;
+                writer.join();
+            }
         }
     }
     